@@ -15,6 +15,26 @@
  * - Configurable resize policies
  * - Comprehensive error handling
  * - Quality-of-life macros for common operations
+ * - Copy-free cursors for sequential, reverse and strided scans
+ * - Structure-of-arrays storage for struct elements
+ * - Bit-packed arrays for boolean elements
+ * - Ring buffers with O(1) push and pop at both ends
+ * - d-ary heaps (priority queues) stored in dynamic arrays
+ * - Optional hash indexes for O(1) key lookups
+ * - Slab allocation of array headers
+ * - Opt-in performance counters
+ * - Incremental resizing without latency spikes
+ * - Adaptive resizing driven by each array's growth history
+ * - Aligned and hugepage-backed element storage
+ * - Operation traces and replay for tuning resize policies
+ * - Sparse arrays for large, mostly-empty index spaces
+ * - Zero-copy slices, strided views and 2-D views
+ * - Compressed storage for cold integer arrays
+ * - Chunked ingest from and write-out to files and descriptors
+ * - Copy, move and destroy hooks for owning element types
+ * - K-way merge and deduplication of sorted arrays
+ * - Byte buffers with bulk and formatted appends
+ * - Typed numeric reductions and element-wise kernels
  * 
  * @section usage_sec Basic Usage
  * 
@@ -47,5 +67,21 @@
 #include "./cdyar_structures.h"
 #include "./cdyar_types.h"
 #include "./cdyar_macros.h"
+#include "./cdyar_cursor.h"
+#include "./cdyar_soa.h"
+#include "./cdyar_bits.h"
+#include "./cdyar_ring.h"
+#include "./cdyar_heap.h"
+#include "./cdyar_hashindex.h"
+#include "./cdyar_slab.h"
+#include "./cdyar_stats.h"
+#include "./cdyar_trace.h"
+#include "./cdyar_memory.h"
+#include "./cdyar_sparse.h"
+#include "./cdyar_view.h"
+#include "./cdyar_packed.h"
+#include "./cdyar_io.h"
+#include "./cdyar_merge.h"
+#include "./cdyar_bytes.h"
 
 #endif
\ No newline at end of file
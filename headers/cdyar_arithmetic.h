@@ -1,10 +1,33 @@
 /**
  * @file cdyar_arithmetic.h
- * @brief Safe arithmetic operations with overflow detection
+ * @brief Safe arithmetic operations and numeric kernels
  * 
  * This file provides utility functions for performing arithmetic operations
  * with automatic overflow detection. These are used internally by cdyar to
  * ensure memory calculations don't overflow.
+ *
+ * It also provides reductions (sum, min, max, mean, dot product) and
+ * element-wise operations (add, scale, clamp) over arrays created with a
+ * numeric type tag (CDYAR_ARR_INT32, CDYAR_ARR_INT64, CDYAR_ARR_FLOAT or
+ * CDYAR_ARR_DOUBLE). They run straight over the elements buffer, one
+ * kernel per element type, instead of one cdyar_get() per element. The
+ * kernels are plain loops over restrict pointers, with reductions split
+ * over several independent accumulators, written so that the compiler
+ * vectorizes them for the target's SIMD instructions; the makefile turns
+ * on gcc's loop vectorizer for them in release builds, which -O2 alone
+ * only applies to the simplest loops. On baseline x86-64 (SSE2), the
+ * int64_t min, max, scale and clamp and the integer dot products stay
+ * scalar, since SSE2 has no packed 64-bit multiply or compare; build with
+ * -march=native (or at least SSE4.2) to vectorize them too.
+ *
+ * Sums and dot products are returned as an int64_t for integer arrays and
+ * as a double for floating-point arrays. Integer arithmetic wraps around
+ * instead of overflowing. Floating-point reductions add in a different
+ * order than a simple loop, so their last bits may differ from one.
+ *
+ * The element-wise operations overwrite every element in place: each one
+ * counts as a set in the array's stats and trace, and an attached hash
+ * index is rebuilt afterwards.
  */
 
 #ifndef H_CDYAR_ARITHMETIC
@@ -88,4 +111,136 @@ void cdyar_check_uint_overflow(const size_t count, cdyar_returncode *code, ...);
 void cdyar_uintpow(const unsigned int base, const unsigned int exponent,
                    unsigned int *outptr, cdyar_returncode *code);
 
+/**
+ * @brief Multiplies two size_t values, detecting overflow
+ *
+ * Non-variadic counterpart of cdyar_check_sizet_overflow for hot paths.
+ * Defined inline so it compiles down to the compiler's overflow-checked
+ * multiplication (__builtin_mul_overflow) where available, and to a
+ * division-based check elsewhere.
+ *
+ * @param left Left operand
+ * @param right Right operand
+ * @param outptr Pointer to where the product will be stored (unspecified
+ *               when the multiplication overflows)
+ * @return cdyar_true if the product doesn't fit in a size_t
+ *
+ * @code
+ * size_t bytes;
+ * if (cdyar_mul_overflows(capacity, typesize, &bytes)) {
+ *     return CDYAR_SIZE_T_OVERFLOW;
+ * }
+ * @endcode
+ */
+static inline cdyar_bool cdyar_mul_overflows(const size_t left,
+                                             const size_t right,
+                                             size_t *outptr) {
+#if defined(__GNUC__) && (__GNUC__ >= 5 || defined(__clang__))
+  return __builtin_mul_overflow(left, right, outptr) ? cdyar_true : cdyar_false;
+#else
+  *outptr = left * right;
+  return (left != 0 && right > SIZE_MAX / left) ? cdyar_true : cdyar_false;
+#endif
+}
+
+/**
+ * @brief Adds up the elements of a numeric array
+ *
+ * @param arr Pointer to the dynamic array (with a numeric type tag)
+ * @param outptr Pointer to an int64_t (integer arrays) or a double
+ *               (floating-point arrays) receiving the sum, 0 if empty
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if the array has
+ *         no numeric type tag, or other error code
+ *
+ * @code
+ * double total;
+ * cdyar_sum(&samples, &total);
+ * @endcode
+ */
+cdyar_returncode cdyar_sum(const cdyar_darray *arr, void *outptr);
+
+/**
+ * @brief Finds the smallest element of a numeric array
+ *
+ * @param arr Pointer to the dynamic array (with a numeric type tag)
+ * @param outptr Pointer to memory receiving the element (typesize bytes)
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if the array
+ *         is empty, CDYAR_INVALID_INPUT if it has no numeric type tag, or
+ *         other error code
+ */
+cdyar_returncode cdyar_min(const cdyar_darray *arr, void *outptr);
+
+/**
+ * @brief Finds the largest element of a numeric array
+ *
+ * @param arr Pointer to the dynamic array (with a numeric type tag)
+ * @param outptr Pointer to memory receiving the element (typesize bytes)
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if the array
+ *         is empty, CDYAR_INVALID_INPUT if it has no numeric type tag, or
+ *         other error code
+ */
+cdyar_returncode cdyar_max(const cdyar_darray *arr, void *outptr);
+
+/**
+ * @brief Computes the arithmetic mean of a numeric array
+ *
+ * @param arr Pointer to the dynamic array (with a numeric type tag)
+ * @param outptr Pointer to where the mean will be stored
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if the array
+ *         is empty, CDYAR_INVALID_INPUT if it has no numeric type tag, or
+ *         other error code
+ */
+cdyar_returncode cdyar_mean(const cdyar_darray *arr, double *outptr);
+
+/**
+ * @brief Computes the dot product of two numeric arrays
+ *
+ * @param left Pointer to the first dynamic array
+ * @param right Pointer to the second dynamic array (same tag and length)
+ * @param outptr Pointer to an int64_t (integer arrays) or a double
+ *               (floating-point arrays) receiving the dot product
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if the arrays
+ *         have no numeric type tag, different tags or different lengths, or
+ *         other error code (reported in left's code)
+ */
+cdyar_returncode cdyar_dot(const cdyar_darray *left, const cdyar_darray *right,
+                           void *outptr);
+
+/**
+ * @brief Adds the elements of one numeric array to those of another
+ *
+ * Computes dst[i] += src[i] for every element.
+ *
+ * @param dst Pointer to the dynamic array that is updated
+ * @param src Pointer to the dynamic array added to it (same tag and length,
+ *            may be dst itself)
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if the arrays
+ *         have no numeric type tag, different tags or different lengths, or
+ *         other error code
+ */
+cdyar_returncode cdyar_add(cdyar_darray *dst, const cdyar_darray *src);
+
+/**
+ * @brief Multiplies every element of a numeric array by a factor
+ *
+ * @param arr Pointer to the dynamic array (with a numeric type tag)
+ * @param factorptr Pointer to the factor, of the array's element type
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if the array has
+ *         no numeric type tag, or other error code
+ */
+cdyar_returncode cdyar_scale(cdyar_darray *arr, const void *factorptr);
+
+/**
+ * @brief Limits every element of a numeric array to a range
+ *
+ * @param arr Pointer to the dynamic array (with a numeric type tag)
+ * @param lowptr Pointer to the lower bound, of the array's element type
+ * @param highptr Pointer to the upper bound, of the array's element type
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if the array has
+ *         no numeric type tag or the lower bound is above the upper one, or
+ *         other error code
+ */
+cdyar_returncode cdyar_clamp(cdyar_darray *arr, const void *lowptr,
+                             const void *highptr);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,162 @@
+/**
+ * @file cdyar_bits.h
+ * @brief Bit-packed dynamic array for boolean elements
+ *
+ * A cdyar_bitarray stores one element per bit in 64-bit words, using eight
+ * times less memory than a cdyar_darray of _Bool or char flags. It follows
+ * the same growth and error code conventions as cdyar_darray, and adds
+ * word-wide operations (population count, find-first-set and bulk
+ * AND/OR/XOR) that process 64 elements at a time.
+ */
+
+#ifndef H_CDYAR_BITS
+#define H_CDYAR_BITS
+
+/** @brief Number of bits stored in one word of a bit array */
+#define CDYAR_BITS_PER_WORD 64
+
+#include "./cdyar_error.h"      //for cdyar_returncode
+#include "./cdyar_structures.h" //for cdyar_bool
+#include <stdint.h>             //for uint64_t
+#include <stdlib.h>             //for size_t
+
+/**
+ * @struct cdyar_bitarray
+ * @brief Dynamic array of bits
+ *
+ * Bits at positions length and above are always kept at zero, so that
+ * word-wide operations never have to mask the last word.
+ */
+typedef struct cdyar_bitarray {
+  uint64_t *words;        /**< Pointer to the array's words */
+  size_t length;          /**< Number of bits currently in the array */
+  size_t capacity;        /**< Number of bits the array can hold (multiple of 64) */
+  cdyar_returncode *code; /**< Pointer to return code for error tracking */
+} cdyar_bitarray;
+
+/**
+ * @brief Creates a new bit array
+ *
+ * @param capacity Initial capacity in bits (rounded up to a multiple of 64)
+ * @param outptr Pointer to cdyar_bitarray structure to initialize
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_nbits(const size_t capacity, cdyar_bitarray *outptr);
+
+/**
+ * @brief Destroys a bit array and frees its memory
+ *
+ * @param arr Pointer to the bit array to destroy
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_dbits(cdyar_bitarray *arr);
+
+/**
+ * @brief Sets the bit at the specified index
+ *
+ * Follows the rules of cdyar_set: index may replace an existing bit or
+ * append right after the last one, doubling the capacity if needed.
+ *
+ * @param arr Pointer to the bit array
+ * @param index Index of the bit
+ * @param value New value of the bit
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if index is
+ *         past the end, or other error code
+ */
+cdyar_returncode cdyar_bits_set(cdyar_bitarray *arr, const size_t index,
+                                const cdyar_bool value);
+
+/**
+ * @brief Gets the bit at the specified index
+ *
+ * @param arr Pointer to the bit array
+ * @param index Index of the bit
+ * @param outptr Pointer to where the value of the bit will be stored
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if index is
+ *         out of bounds, or other error code
+ */
+cdyar_returncode cdyar_bits_get(const cdyar_bitarray *arr, const size_t index,
+                                cdyar_bool *outptr);
+
+/**
+ * @brief Appends a bit to the end of the array
+ *
+ * @param arr Pointer to the bit array
+ * @param value Value of the new bit
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_bits_push(cdyar_bitarray *arr, const cdyar_bool value);
+
+/**
+ * @brief Resets every bit of the array to zero
+ *
+ * The length of the array is kept, only the values are cleared.
+ *
+ * @param arr Pointer to the bit array
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_bits_clear(cdyar_bitarray *arr);
+
+/**
+ * @brief Counts the bits that are set in the array
+ *
+ * @param arr Pointer to the bit array
+ * @param outptr Pointer to where the count will be stored
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_bits_popcount(const cdyar_bitarray *arr,
+                                     size_t *outptr);
+
+/**
+ * @brief Finds the first set bit at or after a starting index
+ *
+ * @param arr Pointer to the bit array
+ * @param start Index where the search starts
+ * @param outptr Pointer to where the index of the first set bit will be
+ *               stored, or arr->length if no bit is set from start onwards
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ *
+ * @code
+ * size_t i;
+ * for (cdyar_bits_ffs(&bits, 0, &i); i < bits.length;
+ *      cdyar_bits_ffs(&bits, i + 1, &i)) {
+ *     // bit i is set
+ * }
+ * @endcode
+ */
+cdyar_returncode cdyar_bits_ffs(const cdyar_bitarray *arr, const size_t start,
+                                size_t *outptr);
+
+/**
+ * @brief Computes dst = dst AND src, word by word
+ *
+ * @param dst Pointer to the destination bit array
+ * @param src Pointer to the source bit array (must have the same length)
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if the lengths
+ *         differ, or other error code
+ */
+cdyar_returncode cdyar_bits_and(cdyar_bitarray *dst,
+                                const cdyar_bitarray *src);
+
+/**
+ * @brief Computes dst = dst OR src, word by word
+ *
+ * @param dst Pointer to the destination bit array
+ * @param src Pointer to the source bit array (must have the same length)
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if the lengths
+ *         differ, or other error code
+ */
+cdyar_returncode cdyar_bits_or(cdyar_bitarray *dst, const cdyar_bitarray *src);
+
+/**
+ * @brief Computes dst = dst XOR src, word by word
+ *
+ * @param dst Pointer to the destination bit array
+ * @param src Pointer to the source bit array (must have the same length)
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if the lengths
+ *         differ, or other error code
+ */
+cdyar_returncode cdyar_bits_xor(cdyar_bitarray *dst,
+                                const cdyar_bitarray *src);
+
+#endif
@@ -0,0 +1,128 @@
+/**
+ * @file cdyar_bytes.h
+ * @brief Byte buffer and string builder operations on dynamic arrays
+ *
+ * These functions treat a dynamic array with a typesize of 1 as a growable
+ * byte buffer. Spans of bytes and formatted text are appended with one
+ * memcpy or vsnprintf straight into the spare capacity instead of one
+ * cdyar_set() and type handler call per byte, and code that produces its
+ * output in place (encoders, compressors, read()) can reserve room, write
+ * into it and then commit what it wrote.
+ *
+ * The buffer grows like a bulk append does: to twice its capacity, or to
+ * what the new bytes need if that is more. The bytes don't go through the
+ * type handler or the type descriptor, but are added to an attached hash
+ * index like bytes appended with cdyar_set().
+ *
+ * @code
+ * cdyar_darray msg;
+ * cdyar_narr(1, 256, CDYAR_DEFAULT_RESIZE_POLICY, cdyar_generic_typehandler,
+ *            CDYAR_ARR_AUTO_RESIZE, &msg);
+ * cdyar_bytes_appendf(&msg, "GET %s HTTP/1.1\r\n", path);
+ * cdyar_bytes_append(&msg, "\r\n", 2);
+ * send(sock, msg.elements, msg.length, 0);
+ * @endcode
+ */
+
+#ifndef H_CDYAR_BYTES
+#define H_CDYAR_BYTES
+
+#include "./cdyar_darray.h" //for cdyar_darray
+#include "./cdyar_error.h"  //for cdyar_returncode
+#include <stdarg.h>         //for va_list
+#include <stdlib.h>         //for size_t
+
+/**
+ * @brief Appends a span of bytes to a byte buffer
+ *
+ * @param arr Pointer to the dynamic array (typesize 1)
+ * @param data Pointer to the bytes to append (may point into arr itself)
+ * @param size Number of bytes to append
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if the array is
+ *         not a byte buffer or data is NULL, or other error code
+ */
+cdyar_returncode cdyar_bytes_append(cdyar_darray *arr, const void *data,
+                                    const size_t size);
+
+/**
+ * @brief Appends formatted text to a byte buffer
+ *
+ * The text is formatted by vsnprintf directly into the spare capacity; only
+ * when it doesn't fit is the buffer grown and the text formatted a second
+ * time. The terminating zero is not part of the buffer's length.
+ *
+ * @param arr Pointer to the dynamic array (typesize 1)
+ * @param format printf format string
+ * @param ... Arguments of the format
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if the array is
+ *         not a byte buffer or the format is invalid, or other error code
+ */
+cdyar_returncode cdyar_bytes_appendf(cdyar_darray *arr, const char *format,
+                                     ...);
+
+/**
+ * @brief Appends formatted text to a byte buffer, with a va_list
+ *
+ * @param arr Pointer to the dynamic array (typesize 1)
+ * @param format printf format string
+ * @param args Arguments of the format
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise (see
+ *         cdyar_bytes_appendf())
+ */
+cdyar_returncode cdyar_bytes_appendv(cdyar_darray *arr, const char *format,
+                                     va_list args);
+
+/**
+ * @brief Makes room for bytes to be written in place
+ *
+ * Grows the buffer so that at least size bytes follow its last byte and
+ * hands out a pointer to them. Nothing is appended until
+ * cdyar_bytes_commit() is called. The pointer is invalidated by any other
+ * operation that grows the buffer.
+ *
+ * @param arr Pointer to the dynamic array (typesize 1)
+ * @param size Number of bytes to make room for
+ * @param outptr Pointer to where the address of the room will be stored
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if the array is
+ *         not a byte buffer, or other error code
+ *
+ * @code
+ * char *room;
+ * cdyar_bytes_reserve(&out, 4096, &room);
+ * ssize_t got = read(fd, room, 4096);
+ * if (got > 0) cdyar_bytes_commit(&out, (size_t)got);
+ * @endcode
+ */
+cdyar_returncode cdyar_bytes_reserve(cdyar_darray *arr, const size_t size,
+                                     char **outptr);
+
+/**
+ * @brief Appends bytes written in place after cdyar_bytes_reserve()
+ *
+ * Bytes written into the reserved room but not committed should be set
+ * back to zero, since the spare capacity of an array is expected to be
+ * zeroed.
+ *
+ * @param arr Pointer to the dynamic array (typesize 1)
+ * @param size Number of bytes written at the end of the buffer
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if size is
+ *         larger than the spare capacity, or other error code
+ */
+cdyar_returncode cdyar_bytes_commit(cdyar_darray *arr, const size_t size);
+
+/**
+ * @brief Zero-terminated view of a byte buffer
+ *
+ * Makes sure a zero byte follows the last byte of the buffer (growing it by
+ * one byte if it is full) and hands out the buffer as a C string. The zero
+ * is not part of the length. The view is invalidated by any operation that
+ * modifies the buffer.
+ *
+ * @param arr Pointer to the dynamic array (typesize 1)
+ * @param outptr Pointer to where the address of the string will be stored
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if the array is
+ *         not a byte buffer, or other error code
+ */
+cdyar_returncode cdyar_bytes_cstr(cdyar_darray *arr, const char **outptr);
+
+#endif
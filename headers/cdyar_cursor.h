@@ -0,0 +1,108 @@
+/**
+ * @file cdyar_cursor.h
+ * @brief Lightweight cursors for scanning dynamic arrays without copies
+ *
+ * A cursor walks the elements of a dynamic array and yields pointers
+ * directly into the array's buffer. Scans built on cursors avoid the
+ * per-element copy and the type handler call that cdyar_get performs.
+ * Forward, reverse and strided traversal are all expressed through the
+ * step passed when the cursor is created.
+ */
+
+#ifndef H_CDYAR_CURSOR
+#define H_CDYAR_CURSOR
+
+/** @brief Prefetch distance that disables software prefetching */
+#define CDYAR_CURSOR_NO_PREFETCH 0
+
+#include "./cdyar_darray.h" //for cdyar_darray
+#include "./cdyar_error.h"  //for cdyar_returncode
+#include <stddef.h>         //for ptrdiff_t
+#include <stdint.h>         //for uintptr_t
+
+/**
+ * @struct cdyar_cursor
+ * @brief Iteration state over the elements of a dynamic array
+ *
+ * A cursor does not own anything and does not need to be destroyed. It
+ * becomes invalid as soon as the array it was created from is resized,
+ * destroyed or has elements removed. The yielded pointers may be written
+ * through, but an array that shares its buffer with a clone must call
+ * cdyar_unshare() first.
+ */
+typedef struct cdyar_cursor {
+  char *current;      /**< Pointer to the next element to be yielded */
+  ptrdiff_t stride;   /**< Distance in bytes between two yielded elements */
+  size_t remaining;   /**< Number of elements left to yield */
+  ptrdiff_t prefetch; /**< Prefetch distance in bytes (0 disables prefetching) */
+} cdyar_cursor;
+
+/**
+ * @brief Creates a cursor over a dynamic array
+ *
+ * The cursor starts at index start and moves step elements at a time
+ * until it leaves the array. A step of 1 gives a forward scan, a step of
+ * -1 (starting at length - 1) gives a reverse scan, and any other
+ * non-zero step gives a strided scan. A cursor over an empty array is
+ * valid and yields nothing. An incremental resize in progress is
+ * completed first (see cdyar_finishresize()).
+ *
+ * @param arr Pointer to the dynamic array to scan
+ * @param start Index of the first element to yield
+ * @param step Number of elements to move after each yield (must not be 0)
+ * @param prefetch Prefetch distance hint in steps, or
+ *                 CDYAR_CURSOR_NO_PREFETCH to disable software prefetching
+ * @param outptr Pointer to the cursor to initialize
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if start is
+ *         not a valid index, CDYAR_INVALID_INPUT if step is 0 or outptr is
+ *         NULL, or other error code
+ *
+ * @code
+ * cdyar_cursor cursor;
+ * cdyar_ncursor(&my_array, 0, 1, 8, &cursor);
+ * for (int *x; (x = cdyar_cursor_next(&cursor));) {
+ *     sum += *x;
+ * }
+ * @endcode
+ */
+cdyar_returncode cdyar_ncursor(cdyar_darray *arr, const size_t start,
+                               const ptrdiff_t step, const size_t prefetch,
+                               cdyar_cursor *outptr);
+
+/**
+ * @brief Yields the next element of a cursor
+ *
+ * Defined inline so that scans compile down to a pointer increment. When a
+ * prefetch distance was given, the element that many steps ahead is
+ * prefetched before the current one is returned.
+ *
+ * @param cursor Pointer to the cursor
+ * @return Pointer to the next element inside the array's buffer, or NULL
+ *         when the cursor is exhausted
+ */
+static inline void *cdyar_cursor_next(cdyar_cursor *cursor) {
+  if (cursor->remaining == 0) {
+    return NULL;
+  }
+
+  char *element = cursor->current;
+
+#if defined(__GNUC__)
+  // prefetching never faults, so the address may safely point past the end
+  if (cursor->prefetch != 0) {
+    __builtin_prefetch(
+        (const void *)((uintptr_t)element + (uintptr_t)cursor->prefetch));
+  }
+#endif
+
+  // only advance while there is something left so current never points
+  // outside of the array
+  cursor->remaining--;
+  if (cursor->remaining != 0) {
+    cursor->current += cursor->stride;
+  }
+
+  return element;
+}
+
+#endif
@@ -12,14 +12,52 @@
 /** @brief Default resize policy (NULL uses internal default behavior) */
 #define CDYAR_DEFAULT_RESIZE_POLICY NULL
 
-/** @brief Number of binary flags available for dynamic arrays */
-#define CDYAR_DARRAY_FLAG_COUNT 2
+/**
+ * @brief Maximum number of elements moved by a single operation while an
+ *        incremental resize is in progress
+ */
+#define CDYAR_INCREMENTAL_RESIZE_STEP 8
+
+/**
+ * @brief Page size the adaptive resize policy rounds small increments to
+ */
+#ifndef CDYAR_PAGE_SIZE
+#define CDYAR_PAGE_SIZE 4096
+#endif
+
+/**
+ * @brief Average time in seconds between resizes below which the adaptive
+ *        resize policy considers an array fast-growing
+ */
+#define CDYAR_ADAPTIVE_FAST_INTERVAL 0.01
+
+/**
+ * @brief Average time in seconds between resizes above which the adaptive
+ *        resize policy considers an array slow-growing
+ */
+#define CDYAR_ADAPTIVE_SLOW_INTERVAL 1.0
+
+/** @brief Number of bits used by the flags of dynamic arrays */
+#define CDYAR_DARRAY_FLAG_COUNT 6
+
+/**
+ * @brief Position of the numeric type tag field in the flags of dynamic
+ *        arrays (see CDYAR_ARR_NUMERIC_MASK)
+ */
+#define CDYAR_ARR_NUMERIC_SHIFT 3
+
+/** @brief Bitmask of every dynamic array flag bit (2^FLAG_COUNT - 1) */
+#define CDYAR_DARRAY_FLAG_MASK                                                 \
+  ((cdyar_flag)((1u << CDYAR_DARRAY_FLAG_COUNT) - 1))
 
 #include "./cdyar_arithmetic.h" //for check_sizet_overflow called in cdyar_default_resize_policy
 #include "./cdyar_error.h" //to be able to use cdyar_returncode type + to access error return codes
+#include "./cdyar_memory.h" //for CDYAR_DEFAULT_ALIGNMENT
+#include "./cdyar_stats.h" //for cdyar_stats
 #include "./cdyar_structures.h" //for cdyar_flag
 #include "./cdyar_types.h"
 #include <math.h>   //for internal function
+#include <stdatomic.h> //for the reference count shared between clones
 #include <stdlib.h> //to be able to use size_t
 
 /**
@@ -30,9 +68,46 @@
  */
 enum cdyar_darray_binflags {
   /** Automatically resize the array when accessing out-of-bounds indices */
-  CDYAR_ARR_AUTO_RESIZE = 0b1,
+  CDYAR_ARR_AUTO_RESIZE = 0x1,
+  /** Keep the return code inside the structure instead of allocating it
+      separately. The structure must then not be moved or copied by value
+      after creation, since code points into it. */
+  CDYAR_ARR_INLINE_CODE = 0x2,
+  /** Hint the kernel to back the elements buffer with transparent
+      hugepages once it reaches CDYAR_HUGEPAGE_THRESHOLD bytes (Linux only) */
+  CDYAR_ARR_HUGEPAGES = 0x4,
+  /** Elements are int32_t (numeric type tag, see CDYAR_ARR_NUMERIC_MASK) */
+  CDYAR_ARR_INT32 = 1 << CDYAR_ARR_NUMERIC_SHIFT,
+  /** Elements are int64_t (numeric type tag) */
+  CDYAR_ARR_INT64 = 2 << CDYAR_ARR_NUMERIC_SHIFT,
+  /** Elements are float (numeric type tag) */
+  CDYAR_ARR_FLOAT = 3 << CDYAR_ARR_NUMERIC_SHIFT,
+  /** Elements are double (numeric type tag) */
+  CDYAR_ARR_DOUBLE = 4 << CDYAR_ARR_NUMERIC_SHIFT,
 };
 
+/**
+ * @brief Bits of the flags holding the numeric type tag
+ *
+ * Unlike the other flags, the numeric tags are not single bits but the
+ * values 1 to 4 of one 3-bit field starting at CDYAR_ARR_NUMERIC_SHIFT
+ * (0 meaning untagged). At most one tag can be given: OR-ing two of them
+ * doesn't combine them but yields another value of the field, either a
+ * different tag (CDYAR_ARR_INT32 | CDYAR_ARR_INT64 is CDYAR_ARR_FLOAT) or
+ * a value above 4, which is rejected. The typesize must match the tag.
+ * Tagged arrays can be used with the numeric kernels of
+ * cdyar_arithmetic.h.
+ *
+ * @code
+ * cdyar_narr(sizeof(double), 1024, CDYAR_DEFAULT_RESIZE_POLICY,
+ *            cdyar_generic_typehandler,
+ *            CDYAR_ARR_AUTO_RESIZE | CDYAR_ARR_DOUBLE, &samples);
+ * cdyar_flag tag = samples.flags & CDYAR_ARR_NUMERIC_MASK; // CDYAR_ARR_DOUBLE
+ * @endcode
+ */
+#define CDYAR_ARR_NUMERIC_MASK                                                 \
+  ((cdyar_flag)(0x7u << CDYAR_ARR_NUMERIC_SHIFT))
+
 /**
  * @typedef cdyar_resizepolicy
  * @brief Function pointer type for custom resize policy implementations
@@ -47,6 +122,17 @@ enum cdyar_darray_binflags {
 typedef void (*cdyar_resizepolicy)(struct cdyar_darray *arr,
                                    cdyar_returncode *code);
 
+/**
+ * @struct cdyar_growthhistory
+ * @brief Recent growth of an array, kept for the adaptive resize policy
+ */
+typedef struct cdyar_growthhistory {
+  double lastresize; /**< Time of the last resize in seconds (0 if none yet) */
+  double interval;   /**< Moving average of the time between resizes */
+  double rate;       /**< Moving average of elements added per second */
+  size_t lastlength; /**< Length of the array at the last resize */
+} cdyar_growthhistory;
+
 /**
  * @struct cdyar_darray
  * @brief Dynamic array structure with automatic memory management
@@ -59,12 +145,101 @@ typedef struct cdyar_darray {
   size_t length;               /**< Number of elements currently in the array */
   size_t capacity;             /**< Maximum number of elements the array can hold */
   size_t typesize;             /**< Size in bytes of each element */
+  size_t alignment;            /**< Alignment of the elements buffer (0 for malloc's) */
   cdyar_flag flags;            /**< Binary flags controlling array behavior */
   cdyar_resizepolicy policy;   /**< Function pointer to resize policy */
   cdyar_typehandler handler;   /**< Function pointer to type handler */
+  const cdyar_typedesc *type;  /**< Optional lifecycle hooks of the elements (NULL for plain bytes) */
   cdyar_returncode *code;      /**< Pointer to return code for error tracking */
+  struct cdyar_hashindex *index; /**< Optional hash index over the elements (NULL if none) */
+  struct cdyar_trace *trace;   /**< Optional operation trace being recorded (NULL if none) */
+  atomic_size_t *refcount;     /**< Reference count of a buffer shared with clones (NULL if not shared) */
+  void *oldelements;           /**< Buffer being migrated away from by an incremental resize (NULL if none) */
+  size_t pending;              /**< Number of leading elements still living in oldelements */
+  cdyar_growthhistory growth;  /**< Growth history used by cdyar_adaptive_resize_policy */
+  cdyar_returncode status;     /**< Embedded return code, used with CDYAR_ARR_INLINE_CODE */
+#ifdef CDYAR_STATS
+  cdyar_stats stats;           /**< Performance counters (only with CDYAR_STATS) */
+#endif
 } cdyar_darray;
 
+/**
+ * @brief Address of the element at a given index
+ *
+ * While an incremental resize is in progress, the first arr->pending
+ * elements still live in the old buffer and every other index lives in
+ * the new one. Performs no checks; used internally by the library.
+ *
+ * @param arr Pointer to the dynamic array
+ * @param index Index of the element
+ * @return Pointer to the element inside the array's storage
+ */
+static inline void *cdyar_elementptr(const cdyar_darray *arr,
+                                     const size_t index) {
+  char *base = (char *)(index < arr->pending ? arr->oldelements : arr->elements);
+  return base + (arr->typesize * index);
+}
+
+/**
+ * @brief Resize policy that spreads the copy over later operations
+ *
+ * Like the default policy it doubles the capacity, but instead of copying
+ * every element at once it only allocates the new buffer. Each following
+ * cdyar_set() and cdyar_get() then moves at most
+ * CDYAR_INCREMENTAL_RESIZE_STEP elements from the old buffer, so no single
+ * operation pays for the whole copy. Appending alone finishes the
+ * migration long before the array fills up again. The cost is that both
+ * buffers are alive during the migration.
+ *
+ * @param arr Pointer to the dynamic array to resize
+ * @param code Pointer to return code for error reporting
+ *
+ * @code
+ * cdyar_setpolicy(&requests, cdyar_incremental_resize_policy);
+ * @endcode
+ */
+void cdyar_incremental_resize_policy(struct cdyar_darray *arr,
+                                     cdyar_returncode *code);
+
+/**
+ * @brief Resize policy that picks the growth from the array's history
+ *
+ * Every resize is timed, and moving averages of the time between resizes
+ * and of the rate elements are added at are kept in the array. An array
+ * that fills up quickly and at a steady pace (average interval below
+ * CDYAR_ADAPTIVE_FAST_INTERVAL, rate since the last resize within a factor
+ * of two of the average rate) grows 4x, so it resizes less often. An array
+ * that creeps up slowly (average interval above
+ * CDYAR_ADAPTIVE_SLOW_INTERVAL) grows by about as many elements as it adds
+ * over one average interval at its average rate, rounded up to whole pages
+ * of CDYAR_PAGE_SIZE bytes and never more than 2x, so it doesn't hold on
+ * to memory it won't use. Everything else, including the first two
+ * resizes, doubles like the default policy.
+ *
+ * @param arr Pointer to the dynamic array to resize
+ * @param code Pointer to return code for error reporting
+ *
+ * @code
+ * cdyar_setpolicy(&sessions, cdyar_adaptive_resize_policy);
+ * @endcode
+ */
+void cdyar_adaptive_resize_policy(struct cdyar_darray *arr,
+                                  cdyar_returncode *code);
+
+/**
+ * @brief Completes an incremental resize in progress
+ *
+ * Moves every element still in the old buffer and frees it, so that
+ * arr->elements holds the whole array again. Functions that hand out
+ * pointers into the buffer (cursors, clones) call it themselves; code
+ * that reads arr->elements directly must call it first. Does nothing when
+ * no resize is in progress.
+ *
+ * @param arr Pointer to the dynamic array
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_finishresize(cdyar_darray *arr);
+
 /**
  * @brief Creates a new dynamic array
  *
@@ -84,6 +259,39 @@ cdyar_returncode cdyar_narr(const size_t typesize, const size_t capacity,
                             const cdyar_typehandler handler,
                             const cdyar_flag flags, cdyar_darray *outptr);
 
+/**
+ * @brief Creates a new dynamic array with an aligned elements buffer
+ *
+ * Same as cdyar_narr(), but the elements buffer starts at a multiple of
+ * alignment bytes, and keeps doing so across every resize. Each element is
+ * aligned as well when typesize is a multiple of alignment. Note that
+ * resizes of an aligned array copy the buffer instead of using realloc.
+ *
+ * @param typesize Size in bytes of each element
+ * @param capacity Initial capacity (number of elements to allocate space for)
+ * @param alignment Power-of-two alignment in bytes, or
+ *                  CDYAR_DEFAULT_ALIGNMENT for malloc's alignment
+ * @param policy Resize policy function, or CDYAR_DEFAULT_RESIZE_POLICY for default
+ * @param handler Type handler function for copying elements
+ * @param flags Binary flags controlling array behavior (see cdyar_darray_binflags)
+ * @param outptr Pointer to cdyar_darray structure to initialize
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if alignment is
+ *         not a power of two, or other error code
+ *
+ * @code
+ * cdyar_darray samples;
+ * cdyar_narr_aligned(sizeof(float), 1024, 64, CDYAR_DEFAULT_RESIZE_POLICY,
+ *                    cdyar_generic_typehandler, CDYAR_ARR_HUGEPAGES, &samples);
+ * @endcode
+ */
+cdyar_returncode cdyar_narr_aligned(const size_t typesize,
+                                    const size_t capacity,
+                                    const size_t alignment,
+                                    const cdyar_resizepolicy policy,
+                                    const cdyar_typehandler handler,
+                                    const cdyar_flag flags,
+                                    cdyar_darray *outptr);
+
 /**
  * @brief Destroys a dynamic array and frees its memory
  *
@@ -113,9 +321,35 @@ cdyar_returncode
 cdyar_set(cdyar_darray *arr, const size_t index,
           void *valueptr);
 
+/**
+ * @brief Removes the element at the specified index
+ *
+ * Every element after index is shifted one step to the left, so the order
+ * of the remaining elements is preserved.
+ *
+ * @param arr Pointer to the dynamic array
+ * @param index Index of the element to remove
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if index is out
+ *         of bounds, or other error code
+ */
 cdyar_returncode
 cdyar_rm(cdyar_darray* arr, const size_t index);
 
+/**
+ * @brief Removes the element at the specified index in O(1)
+ *
+ * The last element is moved into the removed element's place instead of
+ * shifting everything after it, so the order of the elements is not
+ * preserved.
+ *
+ * @param arr Pointer to the dynamic array
+ * @param index Index of the element to remove
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if index is out
+ *         of bounds, or other error code
+ */
+cdyar_returncode
+cdyar_swaprm(cdyar_darray* arr, const size_t index);
+
 /**
  * @brief Gets an element at the specified index
  *
@@ -131,6 +365,45 @@ cdyar_rm(cdyar_darray* arr, const size_t index);
 cdyar_returncode cdyar_get(const cdyar_darray *arr, const size_t index,
                            void *outptr);
 
+/**
+ * @brief Creates a copy-on-write clone of a dynamic array
+ *
+ * The clone shares the source's elements buffer under a reference count,
+ * so cloning costs O(1) regardless of the array's size. The buffer is
+ * copied only when one of the arrays sharing it is written to (cdyar_set,
+ * cdyar_rm, cdyar_swaprm or a resize); the other arrays keep seeing the
+ * old contents. Clones can therefore serve as cheap snapshots, including
+ * for readers on other threads.
+ *
+ * The clone gets its own return code and does not inherit a hash index.
+ * It must be destroyed with cdyar_darr() like any other array.
+ *
+ * @param src Pointer to the dynamic array to clone
+ * @param outptr Pointer to cdyar_darray structure to initialize
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ *
+ * @code
+ * cdyar_darray snapshot;
+ * cdyar_clone(&config, &snapshot); // O(1)
+ * cdyar_set(&config, 0, &value);   // config copies the buffer here
+ * @endcode
+ */
+cdyar_returncode cdyar_clone(cdyar_darray *src, cdyar_darray *outptr);
+
+/**
+ * @brief Gives a dynamic array a private copy of a shared buffer
+ *
+ * Called internally before every write. Code that writes into
+ * arr->elements directly (for example through a cursor) must call it
+ * first when the array may share its buffer with a clone. Does nothing
+ * when the buffer is not shared.
+ *
+ * @param arr Pointer to the dynamic array
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_MEMORY_ERROR if the buffer
+ *         could not be copied, or other error code
+ */
+cdyar_returncode cdyar_unshare(cdyar_darray *arr);
+
 /**
  * @brief Sets the flags for a dynamic array
  *
@@ -155,4 +428,138 @@ cdyar_returncode cdyar_setflags(cdyar_darray *arr, const cdyar_flag flags);
  */
 cdyar_returncode cdyar_setpolicy(cdyar_darray *arr,
                                  const cdyar_resizepolicy policy);
+
+/**
+ * @brief Sets the lifecycle hooks of the elements of a dynamic array
+ *
+ * Once set, cdyar_set() deep-copies new elements with the copy hook and
+ * destroys the element it replaces, cdyar_rm(), cdyar_swaprm() and
+ * cdyar_darr() destroy the elements they drop, and unsharing a clone's
+ * buffer deep-copies every element. Resizes, shifts and splices move
+ * relocatable elements with memcpy/memmove in one go and call the move
+ * hook per element otherwise. cdyar_get() still copies with the type
+ * handler, so what it returns borrows the element's resources.
+ *
+ * Heaps, views, sorting and file I/O move elements as plain bytes and are
+ * only meant for relocatable types. The descriptor is not copied and must
+ * outlive the array.
+ *
+ * @param arr Pointer to the dynamic array
+ * @param type Pointer to the type descriptor, or NULL for plain bytes
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if the type is
+ *         not relocatable but has no move hook, or other error code
+ *
+ * @code
+ * static const cdyar_typedesc person_type = {
+ *     person_copy, NULL, person_destroy, cdyar_true};
+ * cdyar_settype(&people, &person_type);
+ * @endcode
+ */
+cdyar_returncode cdyar_settype(cdyar_darray *arr, const cdyar_typedesc *type);
+
+/**
+ * @brief Makes room for at least capacity elements with a single resize
+ *
+ * The resize policy is not consulted: the buffer grows to exactly capacity
+ * elements (the new portion zeroed). Does nothing if the array can
+ * already hold that many.
+ *
+ * @param arr Pointer to the dynamic array
+ * @param capacity Number of elements the array must be able to hold
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_reserve(cdyar_darray *arr, const size_t capacity);
+
+/**
+ * @brief Makes room for at least capacity elements, initializing the new
+ *        buffer from several threads
+ *
+ * Like cdyar_reserve(), but the new buffer is allocated with
+ * cdyar_memory_alloc_parallel(): each thread copies and zeroes its own
+ * slice, so page faults are spread over the CPUs and, with a first-touch
+ * NUMA policy, pages over the memory nodes. Buffers too small to be worth
+ * splitting are initialized by the calling thread alone, so this is safe
+ * to use on any machine.
+ *
+ * @param arr Pointer to the dynamic array
+ * @param capacity Number of elements the array must be able to hold
+ * @param threads Number of threads to use, or CDYAR_PARALLEL_AUTO for one
+ *                per online CPU
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ *
+ * @code
+ * cdyar_darray samples;
+ * cdyar_narr(sizeof(double), 1, CDYAR_DEFAULT_RESIZE_POLICY,
+ *            cdyar_generic_typehandler, CDYAR_ARR_AUTO_RESIZE, &samples);
+ * cdyar_reserve_parallel(&samples, (size_t)1 << 30, CDYAR_PARALLEL_AUTO);
+ * @endcode
+ */
+cdyar_returncode cdyar_reserve_parallel(cdyar_darray *arr,
+                                        const size_t capacity,
+                                        const size_t threads);
+
+/**
+ * @brief Appends every element of another array
+ *
+ * The destination grows at most once (to the larger of twice its capacity
+ * and what the elements need) and the elements are copied in bulk with
+ * memcpy rather than one cdyar_set and type handler call per element.
+ * Elements of a type with a copy hook (see cdyar_settype()) are
+ * deep-copied with it instead.
+ *
+ * @param dst Pointer to the dynamic array to append to
+ * @param src Pointer to the dynamic array whose elements are appended
+ *            (may be dst itself)
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if the arrays
+ *         hold elements of different sizes or type descriptors, or other
+ *         error code
+ *
+ * @code
+ * for (size_t t = 0; t < threads; t++) {
+ *     cdyar_append(&results, &partial[t]);
+ * }
+ * @endcode
+ */
+cdyar_returncode cdyar_append(cdyar_darray *dst, cdyar_darray *src);
+
+/**
+ * @brief Moves a range of elements from one array into another
+ *
+ * Removes count elements starting at start from src and inserts them
+ * into dst before index, shifting the elements after them in both arrays.
+ * Attached hash indexes are rebuilt.
+ *
+ * @param dst Pointer to the dynamic array receiving the elements
+ * @param index Position in dst the elements are inserted at (at most
+ *              dst->length)
+ * @param src Pointer to the dynamic array the elements are taken from
+ *            (must not be dst)
+ * @param start Index in src of the first element to move
+ * @param count Number of elements to move
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if index or
+ *         the range is out of bounds, CDYAR_INVALID_INPUT if the arrays are
+ *         the same or hold elements of different sizes or type descriptors,
+ *         or other error code
+ */
+cdyar_returncode cdyar_splice(cdyar_darray *dst, const size_t index,
+                              cdyar_darray *src, const size_t start,
+                              const size_t count);
+
+/**
+ * @brief Appends every element of another array and destroys it
+ *
+ * When dst is empty and src's buffer is not shared with a clone (and is
+ * aligned at least as strictly as dst requires), dst takes over src's
+ * buffer without copying anything. Otherwise the elements are appended
+ * like cdyar_append() does, except that an unshared src hands them over
+ * (moved, not deep-copied) before it is destroyed. On failure src is left
+ * untouched.
+ *
+ * @param dst Pointer to the dynamic array to append to
+ * @param src Pointer to the dynamic array to consume (must not be dst)
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if the arrays
+ *         are the same or hold elements of different sizes or type
+ *         descriptors, or other error code
+ */
+cdyar_returncode cdyar_concat(cdyar_darray *dst, cdyar_darray *src);
 #endif
@@ -10,8 +10,39 @@
     #define H_CDYAR_ERROR
     
     /** @brief Total number of error codes defined in the library */
-    #define CDYAR_ERR_CODE_COUNT 13
+    #define CDYAR_ERR_CODE_COUNT 14
     
+    /** @brief Check level with no runtime checks (violations are only asserted) */
+    #define CDYAR_CHECK_NONE 0
+    /** @brief Check level that keeps argument and bounds checks only */
+    #define CDYAR_CHECK_BOUNDARY 1
+    /** @brief Check level that also detects corrupted arrays at runtime */
+    #define CDYAR_CHECK_FULL 2
+
+    /**
+     * @brief How much validation the library performs at runtime
+     *
+     * - CDYAR_CHECK_FULL: every check returns an error code, including the
+     *   structural checks that detect corrupted arrays (NULL buffers,
+     *   missing handlers, a zero typesize, ...) and NULL code pointers.
+     * - CDYAR_CHECK_BOUNDARY: NULL arguments and out-of-bounds indices
+     *   still return an error code; structural checks become assertions.
+     * - CDYAR_CHECK_NONE: every check becomes an assertion.
+     *
+     * Assertions vanish under NDEBUG, so release builds only pay for the
+     * checks the level keeps. Defaults to CDYAR_CHECK_BOUNDARY when NDEBUG
+     * is defined and to CDYAR_CHECK_FULL otherwise. The library and the
+     * code using it may be built with different levels.
+     */
+    #ifndef CDYAR_CHECK_LEVEL
+        #ifdef NDEBUG
+            #define CDYAR_CHECK_LEVEL CDYAR_CHECK_BOUNDARY
+        #else
+            #define CDYAR_CHECK_LEVEL CDYAR_CHECK_FULL
+        #endif
+    #endif
+
+    #include <assert.h> //for the checks compiled out by CDYAR_CHECK_LEVEL
     #include <stdio.h> //for fprintf in CDYAR_CHECK_CODE
     #include <stdlib.h>
     
@@ -24,16 +55,52 @@
      * This macro checks if the error code pointer is NULL before attempting
      * to use it. If NULL, it prints an error message and aborts the program.
      * Use this at the beginning of functions that accept error code pointers.
+     * Below CDYAR_CHECK_FULL it is only an assertion.
      * 
      * @param code Pointer to error code to validate
      */
-    #define CDYAR_CHECK_CODE(code) \
-        do { \
-            if (!(code)) { \
-                fprintf(stderr, "cdyar: FATAL: NULL error code pointer passed to %s\n", __func__); \
-                abort(); \
-            } \
-        } while(0)
+    #if CDYAR_CHECK_LEVEL >= CDYAR_CHECK_FULL
+        #define CDYAR_CHECK_CODE(code) \
+            do { \
+                if (!(code)) { \
+                    fprintf(stderr, "cdyar: FATAL: NULL error code pointer passed to %s\n", __func__); \
+                    abort(); \
+                } \
+            } while(0)
+    #else
+        #define CDYAR_CHECK_CODE(code) assert(code)
+    #endif
+
+    /**
+     * @brief Condition of a structural check (a corrupted array)
+     *
+     * Evaluates to failure at CDYAR_CHECK_FULL. At lower levels it asserts
+     * that failure is false and evaluates to 0, so the check around it is
+     * compiled out.
+     *
+     * @code
+     * if (CDYAR_STRUCTURE_FAILS(!arr->elements)) {
+     *     *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+     *     return CDYAR_CORRUPTED_DYNAMIC_ARR;
+     * }
+     * @endcode
+     */
+    #if CDYAR_CHECK_LEVEL >= CDYAR_CHECK_FULL
+        #define CDYAR_STRUCTURE_FAILS(failure) (failure)
+    #else
+        #define CDYAR_STRUCTURE_FAILS(failure) (assert(!(failure)), 0)
+    #endif
+
+    /**
+     * @brief Condition of an argument or bounds check
+     *
+     * Like CDYAR_STRUCTURE_FAILS, but kept down to CDYAR_CHECK_BOUNDARY.
+     */
+    #if CDYAR_CHECK_LEVEL >= CDYAR_CHECK_BOUNDARY
+        #define CDYAR_BOUNDARY_FAILS(failure) (failure)
+    #else
+        #define CDYAR_BOUNDARY_FAILS(failure) (assert(!(failure)), 0)
+    #endif
     
     /**
      * @typedef cdyar_returncode
@@ -64,6 +131,8 @@
         CDYAR_ARITHMETIC_NOT_A_NUMBER,      /**< Arithmetic operation resulted in NaN */
         CDYAR_ARITHMETIC_NEGATIVE_EXPONENT, /**< Negative exponent not supported */
         CDYAR_INVALID_DARR_DECLARATION,     /**< Invalid dynamic array declaration */
+        CDYAR_NOT_FOUND,                    /**< Searched element or key does not exist */
+        CDYAR_IO_ERROR,                     /**< Reading or writing a file failed */
     };
     
     /**
@@ -0,0 +1,152 @@
+/**
+ * @file cdyar_hashindex.h
+ * @brief Optional open-addressing hash index over the elements of an array
+ *
+ * A hash index maps a key stored inside each element to the index of that
+ * element, so key lookups take O(1) instead of a linear scan. The index is
+ * attached to a cdyar_darray, which remains the source of truth and stays
+ * contiguous. Once attached, cdyar_set, cdyar_rm and cdyar_swaprm keep it
+ * up to date incrementally.
+ *
+ * Operations that move elements around directly in the buffer (such as a
+ * cdyar_heap sifting its elements, or writes through a cursor) bypass the
+ * index; call cdyar_rebuildindex afterwards.
+ */
+
+#ifndef H_CDYAR_HASHINDEX
+#define H_CDYAR_HASHINDEX
+
+/** @brief Default hash function (NULL uses the internal FNV-1a hash) */
+#define CDYAR_DEFAULT_HASH NULL
+
+#include "./cdyar_darray.h" //for cdyar_darray
+#include "./cdyar_error.h"  //for cdyar_returncode
+#include <stdlib.h>         //for size_t
+
+/**
+ * @typedef cdyar_hashfunction
+ * @brief Function pointer type for hashing the key of an element
+ *
+ * @param key Pointer to the first byte of the key
+ * @param keylength Length of the key in bytes
+ * @return Hash of the key
+ */
+typedef size_t (*cdyar_hashfunction)(const void *key, size_t keylength);
+
+/**
+ * @struct cdyar_hashslot
+ * @brief One slot of a hash index
+ */
+typedef struct cdyar_hashslot {
+  size_t hash;     /**< Cached hash of the key stored in this slot */
+  size_t position; /**< Index of the element plus one, 0 marks an empty slot */
+} cdyar_hashslot;
+
+/**
+ * @struct cdyar_hashindex
+ * @brief Linear-probing hash table from keys to element indices
+ *
+ * Deletions use backward shifting, so the table never accumulates
+ * tombstones. Duplicate keys are allowed.
+ */
+typedef struct cdyar_hashindex {
+  cdyar_hashslot *slots;   /**< Table of slots */
+  size_t slotcount;        /**< Number of slots (always a power of two) */
+  size_t count;            /**< Number of occupied slots */
+  size_t keyoffset;        /**< Offset of the key inside each element */
+  size_t keylength;        /**< Length of the key in bytes */
+  cdyar_hashfunction hash; /**< Function used to hash keys */
+} cdyar_hashindex;
+
+/**
+ * @brief Attaches a hash index to a dynamic array
+ *
+ * Every element currently in the array is indexed right away. Keys are
+ * compared byte by byte, so keys must not contain padding bytes.
+ *
+ * @param arr Pointer to the dynamic array
+ * @param keyoffset Offset in bytes of the key inside each element
+ * @param keylength Length in bytes of the key
+ * @param hash Hash function, or CDYAR_DEFAULT_HASH
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if the key does
+ *         not fit inside an element or the array already has an index, or
+ *         other error code
+ *
+ * @code
+ * cdyar_attachindex(&users, offsetof(user, id), sizeof(uint64_t),
+ *                   CDYAR_DEFAULT_HASH);
+ * size_t where;
+ * if (cdyar_lookup(&users, &wanted_id, &where) == CDYAR_SUCCESSFUL) {
+ *     cdyar_get(&users, where, &found);
+ * }
+ * @endcode
+ */
+cdyar_returncode cdyar_attachindex(cdyar_darray *arr, const size_t keyoffset,
+                                   const size_t keylength,
+                                   const cdyar_hashfunction hash);
+
+/**
+ * @brief Detaches and frees the hash index of a dynamic array
+ *
+ * @param arr Pointer to the dynamic array
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_detachindex(cdyar_darray *arr);
+
+/**
+ * @brief Rebuilds the hash index of a dynamic array from its elements
+ *
+ * @param arr Pointer to the dynamic array
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if the array has
+ *         no index, or other error code
+ */
+cdyar_returncode cdyar_rebuildindex(cdyar_darray *arr);
+
+/**
+ * @brief Finds the index of an element by key
+ *
+ * @param arr Pointer to the dynamic array
+ * @param keyptr Pointer to the key to look up (keylength bytes)
+ * @param outptr Pointer to where the index of the element will be stored
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_NOT_FOUND if no element has
+ *         this key, CDYAR_INVALID_INPUT if the array has no index, or other
+ *         error code
+ */
+cdyar_returncode cdyar_lookup(const cdyar_darray *arr, const void *keyptr,
+                              size_t *outptr);
+
+/*
+    the functions below keep an attached index in sync with the array and
+   are called by cdyar_darray.c, they do nothing when no index is attached.
+   erase must be called while the element still holds its old key.
+*/
+
+/**
+ * @brief Indexes the element at a given position (internal use)
+ *
+ * @param arr Pointer to the dynamic array
+ * @param index Index of the element to add to the index
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_hashindex_insert(cdyar_darray *arr, const size_t index);
+
+/**
+ * @brief Removes the entry of the element at a given position (internal use)
+ *
+ * @param arr Pointer to the dynamic array
+ * @param index Index of the element to remove from the index
+ */
+void cdyar_hashindex_erase(cdyar_darray *arr, const size_t index);
+
+/**
+ * @brief Shifts indexed positions after a removal (internal use)
+ *
+ * Every entry pointing after index is moved one position down, matching
+ * the left shift performed by cdyar_rm. Runs in O(number of slots).
+ *
+ * @param arr Pointer to the dynamic array
+ * @param index Index of the element that was removed
+ */
+void cdyar_hashindex_shift(cdyar_darray *arr, const size_t index);
+
+#endif
@@ -0,0 +1,142 @@
+/**
+ * @file cdyar_heap.h
+ * @brief Priority queue (d-ary min-heap) stored in a dynamic array
+ *
+ * A cdyar_heap arranges the elements of an existing cdyar_darray as an
+ * implicit min-heap, so the smallest element can be found in O(1) and
+ * removed in O(log n) instead of rescanning the whole array. The number of
+ * children per node is configurable: a 4-ary layout keeps siblings within
+ * the same cache lines and halves the depth of large heaps.
+ */
+
+#ifndef H_CDYAR_HEAP
+#define H_CDYAR_HEAP
+
+/** @brief Arity of a classic binary heap */
+#define CDYAR_HEAP_BINARY 2
+
+/** @brief Arity of a 4-ary heap, friendlier to caches on large heaps */
+#define CDYAR_HEAP_QUATERNARY 4
+
+/** @brief Comparator value that selects ordering by an int64_t key */
+#define CDYAR_HEAP_KEY_COMPARATOR NULL
+
+#include "./cdyar_darray.h" //for cdyar_darray
+#include "./cdyar_error.h"  //for cdyar_returncode
+#include "./cdyar_types.h"  //for cdyar_comparator
+#include <stdlib.h>         //for size_t
+
+/**
+ * @struct cdyar_heap
+ * @brief Min-heap view over the elements of a dynamic array
+ *
+ * The heap does not own its storage: the dynamic array stays owned by the
+ * caller and must outlive the heap. Errors are reported through the return
+ * code of that array. Elements are moved around while sifting with memcpy,
+ * or with the move hook of the array's type descriptor (see cdyar_settype()).
+ */
+typedef struct cdyar_heap {
+  cdyar_darray *arr;    /**< Dynamic array holding the heap's elements */
+  cdyar_comparator cmp; /**< Element comparator, or NULL to compare keys */
+  size_t keyoffset;     /**< Offset of the int64_t key when cmp is NULL */
+  size_t arity;         /**< Number of children per node (2 or more) */
+  void *scratch;        /**< One element of scratch space used while sifting */
+} cdyar_heap;
+
+/**
+ * @brief Creates a heap on top of a dynamic array
+ *
+ * Whatever the array already contains is heapified in O(n), so this is
+ * also the way to turn an existing array into a priority queue. Elements
+ * are ordered by cmp, or, when cmp is CDYAR_HEAP_KEY_COMPARATOR, by the
+ * int64_t stored keyoffset bytes into each element.
+ *
+ * @param arr Pointer to the dynamic array used as storage
+ * @param cmp Comparator, or CDYAR_HEAP_KEY_COMPARATOR to order by key
+ * @param keyoffset Offset of the int64_t key (ignored when cmp is given)
+ * @param arity Number of children per node, e.g. CDYAR_HEAP_BINARY or
+ *              CDYAR_HEAP_QUATERNARY
+ * @param outptr Pointer to cdyar_heap structure to initialize
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ *
+ * @code
+ * NEW_CDYAR(tasks, task, 64);
+ * cdyar_heap queue;
+ * cdyar_nheap(&tasks, CDYAR_HEAP_KEY_COMPARATOR, offsetof(task, deadline),
+ *             CDYAR_HEAP_QUATERNARY, &queue);
+ * @endcode
+ */
+cdyar_returncode cdyar_nheap(cdyar_darray *arr, const cdyar_comparator cmp,
+                             const size_t keyoffset, const size_t arity,
+                             cdyar_heap *outptr);
+
+/**
+ * @brief Destroys a heap
+ *
+ * Only the heap's own scratch memory is freed, the underlying dynamic
+ * array is left intact (in heap order) and must be destroyed separately.
+ *
+ * @param heap Pointer to the heap to destroy
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_dheap(cdyar_heap *heap);
+
+/**
+ * @brief Restores the heap property over the whole array
+ *
+ * Call this after the underlying array has been modified directly.
+ *
+ * @param heap Pointer to the heap
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_heap_heapify(cdyar_heap *heap);
+
+/**
+ * @brief Inserts an element into the heap
+ *
+ * @param heap Pointer to the heap
+ * @param valueptr Pointer to the value to insert
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_heap_push(cdyar_heap *heap, void *valueptr);
+
+/**
+ * @brief Removes the smallest element of the heap
+ *
+ * The removed element is handed over to the caller: it is moved into
+ * outptr (through the move hook of the array's type descriptor if it has
+ * one), or destroyed through the destroy hook when outptr is NULL.
+ *
+ * @param heap Pointer to the heap
+ * @param outptr Pointer to memory where the removed element will be
+ *               moved, or NULL to discard it
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if the heap
+ *         is empty, or other error code
+ */
+cdyar_returncode cdyar_heap_pop(cdyar_heap *heap, void *outptr);
+
+/**
+ * @brief Reads the smallest element of the heap without removing it
+ *
+ * @param heap Pointer to the heap
+ * @param outptr Pointer to memory where the element will be copied
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if the heap
+ *         is empty, or other error code
+ */
+cdyar_returncode cdyar_heap_peek(const cdyar_heap *heap, void *outptr);
+
+/**
+ * @brief Replaces an element with a smaller one and restores heap order
+ *
+ * @param heap Pointer to the heap
+ * @param index Index of the element inside the underlying array
+ * @param valueptr Pointer to the new value, which must not order after
+ *                 the element it replaces
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if index is
+ *         out of bounds, CDYAR_INVALID_INPUT if the new value is larger, or
+ *         other error code
+ */
+cdyar_returncode cdyar_heap_decreasekey(cdyar_heap *heap, const size_t index,
+                                        void *valueptr);
+
+#endif
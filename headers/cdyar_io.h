@@ -0,0 +1,118 @@
+/**
+ * @file cdyar_io.h
+ * @brief Bulk reading and writing of dynamic arrays from files
+ *
+ * The ingest functions read a stream of raw elements (typesize bytes each,
+ * in the machine's byte order) straight into the spare capacity of a
+ * dynamic array, CDYAR_IO_CHUNK bytes at a time. When the array fills up
+ * its resize policy is called, exactly as cdyar_set() would. A chunk that
+ * ends in the middle of an element keeps the partial bytes in place and
+ * completes them with the next read, and length grows once per chunk
+ * instead of once per element.
+ *
+ * The write functions do the reverse and write the elements out in chunks
+ * of the same size, so an array written with cdyar_writefile() is read
+ * back by cdyar_readfile().
+ *
+ * Elements are copied as bytes, not through the array's type handler.
+ * Arrays whose type descriptor (see cdyar_settype()) has a destroy hook or
+ * is not relocatable hold elements that can't be represented by their
+ * bytes alone, so every function here rejects them with
+ * CDYAR_INVALID_INPUT.
+ * File descriptors are only supported where CDYAR_IO_HAS_FD is defined.
+ */
+
+#ifndef H_CDYAR_IO
+#define H_CDYAR_IO
+
+/** @brief Largest number of bytes moved by a single read or write */
+#ifndef CDYAR_IO_CHUNK
+#define CDYAR_IO_CHUNK ((size_t)1 << 20)
+#endif
+
+/** @brief Defined when the file descriptor functions are available */
+#if defined(__unix__) || defined(__APPLE__)
+#define CDYAR_IO_HAS_FD 1
+#endif
+
+#include "./cdyar_darray.h" //for cdyar_darray
+#include "./cdyar_error.h"  //for cdyar_returncode
+#include <stdio.h>          //for FILE
+#include <stdlib.h>         //for size_t
+
+/**
+ * @brief Appends every element of a stream to a dynamic array
+ *
+ * Reads until the end of the stream. Elements read before an error stay
+ * in the array.
+ *
+ * @param arr Pointer to the dynamic array
+ * @param stream Stream opened for reading in binary mode
+ * @param outptr Pointer to where the number of elements read will be
+ *               stored, or NULL
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_IO_ERROR if reading failed or
+ *         the stream ended in the middle of an element, CDYAR_INVALID_INPUT
+ *         if the array's elements own resources, or other error code
+ *
+ * @code
+ * FILE *f = fopen("samples.bin", "rb");
+ * size_t count;
+ * cdyar_readfile(&samples, f, &count);
+ * fclose(f);
+ * @endcode
+ */
+cdyar_returncode cdyar_readfile(cdyar_darray *arr, FILE *stream,
+                                size_t *outptr);
+
+/**
+ * @brief Writes every element of a dynamic array to a stream
+ *
+ * An incremental resize in progress is completed first (see
+ * cdyar_finishresize()).
+ *
+ * @param arr Pointer to the dynamic array
+ * @param stream Stream opened for writing in binary mode
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_IO_ERROR if writing failed,
+ *         CDYAR_INVALID_INPUT if the array's elements own resources, or
+ *         other error code
+ */
+cdyar_returncode cdyar_writefile(cdyar_darray *arr, FILE *stream);
+
+#ifdef CDYAR_IO_HAS_FD
+
+/**
+ * @brief Appends every element read from a file descriptor to a dynamic
+ *        array
+ *
+ * Like cdyar_readfile(), but reads with read(2), retrying reads
+ * interrupted by a signal. Works with pipes and sockets as well as
+ * regular files.
+ *
+ * @param arr Pointer to the dynamic array
+ * @param fd File descriptor open for reading
+ * @param outptr Pointer to where the number of elements read will be
+ *               stored, or NULL
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_IO_ERROR if reading failed or
+ *         the input ended in the middle of an element, CDYAR_INVALID_INPUT
+ *         if the array's elements own resources, or other error code
+ */
+cdyar_returncode cdyar_readfd(cdyar_darray *arr, const int fd,
+                              size_t *outptr);
+
+/**
+ * @brief Writes every element of a dynamic array to a file descriptor
+ *
+ * Like cdyar_writefile(), but writes with write(2), continuing after
+ * short writes and writes interrupted by a signal.
+ *
+ * @param arr Pointer to the dynamic array
+ * @param fd File descriptor open for writing
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_IO_ERROR if writing failed,
+ *         CDYAR_INVALID_INPUT if the array's elements own resources, or
+ *         other error code
+ */
+cdyar_returncode cdyar_writefd(cdyar_darray *arr, const int fd);
+
+#endif
+
+#endif
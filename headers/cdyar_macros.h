@@ -89,4 +89,39 @@
  */
 #define DELETE_CDYAR_ONHEAP(name) cdyar_darr(name); free(name)
 
+/**
+ * @brief Creates a new dynamic array from a slab with default settings
+ * 
+ * Same defaults as NEW_CDYAR, but the array's header (and its return code)
+ * come from a cdyar_slab, so creating the array costs a single allocation
+ * for its data once the slab has warmed up.
+ * 
+ * @param name Pointer variable name for the array
+ * @param slab Pointer to the slab to take the header from
+ * @param type Data type of elements (e.g., int, double, struct MyStruct)
+ * @param capacity Initial capacity of the array
+ * 
+ * @code
+ * cdyar_slab slab;
+ * cdyar_nslab(CDYAR_SLAB_DEFAULT_CHUNK, &slab);
+ * NEW_CDYAR_FROMSLAB(my_array, &slab, int, 100);
+ * // ... use the array ...
+ * DELETE_CDYAR_FROMSLAB(&slab, my_array);
+ * @endcode
+ */
+#define NEW_CDYAR_FROMSLAB(name, slab, type, capacity)                         \
+  cdyar_darray *name = NULL;                                                   \
+  cdyar_slab_narr(slab, sizeof(type), capacity, CDYAR_DEFAULT_RESIZE_POLICY,   \
+                  cdyar_generic_typehandler, CDYAR_ARR_AUTO_RESIZE, &name);
+
+/**
+ * @brief Destroys a dynamic array created with NEW_CDYAR_FROMSLAB
+ * 
+ * Frees the array's data and returns its header to the slab.
+ * 
+ * @param slab Pointer to the slab the array was created from
+ * @param name Pointer to the array to destroy
+ */
+#define DELETE_CDYAR_FROMSLAB(slab, name) cdyar_slab_darr(slab, name)
+
 #endif
\ No newline at end of file
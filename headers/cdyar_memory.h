@@ -0,0 +1,124 @@
+/**
+ * @file cdyar_memory.h
+ * @brief Aligned and hugepage-aware allocation of element buffers
+ *
+ * malloc and realloc only guarantee the alignment of the largest
+ * fundamental type (16 bytes on common 64-bit targets), and realloc can't
+ * be asked for more. These functions allocate element buffers with any
+ * power-of-two alignment and keep it across reallocation, falling back to
+ * plain malloc/calloc/realloc when no alignment is requested. Buffers they
+ * return are released with free().
+ *
+ * They can also hint the kernel to back large buffers with transparent
+ * hugepages (MADV_HUGEPAGE). The hint is only given on Linux and is
+ * silently skipped elsewhere.
+ */
+
+#ifndef H_CDYAR_MEMORY
+#define H_CDYAR_MEMORY
+
+/** @brief Alignment that keeps the platform's malloc alignment */
+#define CDYAR_DEFAULT_ALIGNMENT 0
+
+/** @brief Size in bytes from which buffers get the hugepage hint */
+#ifndef CDYAR_HUGEPAGE_THRESHOLD
+#define CDYAR_HUGEPAGE_THRESHOLD ((size_t)2 * 1024 * 1024)
+#endif
+
+/** @brief Smallest share of a buffer worth handing to a separate thread */
+#ifndef CDYAR_PARALLEL_MIN_SLICE
+#define CDYAR_PARALLEL_MIN_SLICE ((size_t)16 * 1024 * 1024)
+#endif
+
+/** @brief Thread count that lets the library pick one per online CPU */
+#define CDYAR_PARALLEL_AUTO 0
+
+#include "./cdyar_structures.h" //for cdyar_bool
+#include <stdlib.h>             //for size_t
+
+/**
+ * @brief Checks whether an alignment can be requested
+ *
+ * @param alignment Alignment in bytes
+ * @return cdyar_true if alignment is CDYAR_DEFAULT_ALIGNMENT or a power of
+ *         two, cdyar_false otherwise
+ */
+cdyar_bool cdyar_memory_validalignment(const size_t alignment);
+
+/**
+ * @brief Allocates a zeroed buffer
+ *
+ * @param size Size of the buffer in bytes (must not be 0)
+ * @param alignment Power-of-two alignment of the buffer, or
+ *                  CDYAR_DEFAULT_ALIGNMENT
+ * @param hugepages Whether to hint hugepages if size reaches
+ *                  CDYAR_HUGEPAGE_THRESHOLD
+ * @return Pointer to the buffer, or NULL if the allocation failed
+ */
+void *cdyar_memory_calloc(const size_t size, const size_t alignment,
+                          const cdyar_bool hugepages);
+
+/**
+ * @brief Allocates a buffer without initializing it
+ *
+ * @param size Size of the buffer in bytes (must not be 0)
+ * @param alignment Power-of-two alignment of the buffer, or
+ *                  CDYAR_DEFAULT_ALIGNMENT
+ * @param hugepages Whether to hint hugepages if size reaches
+ *                  CDYAR_HUGEPAGE_THRESHOLD
+ * @return Pointer to the buffer, or NULL if the allocation failed
+ */
+void *cdyar_memory_alloc(const size_t size, const size_t alignment,
+                         const cdyar_bool hugepages);
+
+/**
+ * @brief Resizes a buffer while keeping its alignment
+ *
+ * Without an alignment this is realloc. With one, a new aligned buffer is
+ * allocated and the first min(oldsize, newsize) bytes are copied over. On
+ * failure the old buffer is left untouched, as with realloc.
+ *
+ * @param ptr Buffer returned by one of these functions
+ * @param oldsize Current size of the buffer in bytes
+ * @param newsize New size of the buffer in bytes (must not be 0)
+ * @param alignment Alignment the buffer was allocated with
+ * @param hugepages Whether to hint hugepages if newsize reaches
+ *                  CDYAR_HUGEPAGE_THRESHOLD
+ * @return Pointer to the resized buffer, or NULL if the allocation failed
+ */
+void *cdyar_memory_realloc(void *ptr, const size_t oldsize,
+                           const size_t newsize, const size_t alignment,
+                           const cdyar_bool hugepages);
+
+/**
+ * @brief Allocates a buffer and initializes it from several threads
+ *
+ * The buffer is split into page-aligned slices, one per thread. Each
+ * thread copies its part of the first copysize bytes from src and zeroes
+ * the rest of its slice, so that it is the first to touch those pages.
+ * This spreads the page faults of a multi-gigabyte buffer over several
+ * CPUs, and on NUMA machines with a first-touch policy it spreads the
+ * pages over their memory nodes.
+ *
+ * Slices are never smaller than CDYAR_PARALLEL_MIN_SLICE, so small buffers
+ * are initialized by the calling thread alone. Without C11 threads
+ * (__STDC_NO_THREADS__) or if threads can't be started, the remaining
+ * slices are initialized by the calling thread; the result is the same.
+ *
+ * @param size Size of the buffer in bytes (must not be 0)
+ * @param alignment Power-of-two alignment of the buffer, or
+ *                  CDYAR_DEFAULT_ALIGNMENT
+ * @param hugepages Whether to hint hugepages if size reaches
+ *                  CDYAR_HUGEPAGE_THRESHOLD
+ * @param src Bytes to copy to the start of the buffer (may be NULL if
+ *            copysize is 0)
+ * @param copysize Number of bytes to copy from src (at most size)
+ * @param threads Number of threads to use, or CDYAR_PARALLEL_AUTO for one
+ *                per online CPU
+ * @return Pointer to the buffer, or NULL if the allocation failed
+ */
+void *cdyar_memory_alloc_parallel(const size_t size, const size_t alignment,
+                                  const cdyar_bool hugepages, const void *src,
+                                  const size_t copysize, size_t threads);
+
+#endif
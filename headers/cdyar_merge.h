@@ -0,0 +1,68 @@
+/**
+ * @file cdyar_merge.h
+ * @brief Merging and deduplicating sorted dynamic arrays
+ *
+ * cdyar_merge() combines any number of arrays sorted by the same
+ * comparator into one sorted run. The destination is grown once for every
+ * element, and the next element is picked with a loser tree: each step
+ * replays a single leaf-to-root path of log2(k) comparisons, against the
+ * k - 1 comparisons of scanning the heads of all k sources.
+ *
+ * cdyar_unique() then drops (or folds together) equivalent neighbours of a
+ * sorted array in a single in-place pass.
+ *
+ * @code
+ * cdyar_darray *shards[] = {&shard0, &shard1, &shard2};
+ * cdyar_merge(&all, shards, 3, compare_keys);
+ * cdyar_unique(&all, compare_keys, add_counts);
+ * @endcode
+ */
+
+#ifndef H_CDYAR_MERGE
+#define H_CDYAR_MERGE
+
+#include "./cdyar_darray.h" //for cdyar_darray
+#include "./cdyar_error.h"  //for cdyar_returncode
+#include "./cdyar_types.h"  //for cdyar_comparator and cdyar_reducer
+#include <stdlib.h>         //for size_t
+
+/**
+ * @brief Appends the elements of several sorted arrays to an array, in order
+ *
+ * The merge is stable: equivalent elements keep the order of the sources
+ * they come from, and their order within each source. Elements are copied
+ * with memcpy, or with the copy hook of dst's type descriptor (see
+ * cdyar_settype()). The sources are not modified.
+ *
+ * @param dst Pointer to the dynamic array to append to (must not be one of
+ *            the sources)
+ * @param srcs Array of count pointers to arrays sorted by cmp, holding
+ *             elements of dst's size
+ * @param count Number of sources
+ * @param cmp Comparator the sources are sorted by
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if a source is
+ *         NULL, dst itself or holds elements of another size or type
+ *         descriptor, or other error code
+ */
+cdyar_returncode cdyar_merge(cdyar_darray *dst, cdyar_darray *const *srcs,
+                             const size_t count, const cdyar_comparator cmp);
+
+/**
+ * @brief Removes consecutive equivalent elements of a sorted array
+ *
+ * Keeps the first element of every run of elements comparing equal. With
+ * a reducer, every later element of the run is folded into the kept one
+ * before it is dropped; dropped elements are destroyed through the array's
+ * type descriptor if it has a destroy hook. Attached hash indexes are
+ * rebuilt.
+ *
+ * @param arr Pointer to the dynamic array
+ * @param cmp Comparator the array is sorted by
+ * @param reduce Function combining a duplicate into the kept element, or
+ *               NULL to just drop duplicates
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_unique(cdyar_darray *arr, const cdyar_comparator cmp,
+                              const cdyar_reducer reduce);
+
+#endif
@@ -0,0 +1,142 @@
+/**
+ * @file cdyar_packed.h
+ * @brief Compressed, read-only storage for cold integer arrays
+ *
+ * A cdyar_packed holds a copy of a dynamic array of 32- or 64-bit integers
+ * in blocks of CDYAR_PACKED_BLOCK_SIZE elements. Each block stores its
+ * values bit-packed with just enough bits for the block, using either:
+ * - frame of reference: every value minus the block's minimum, or
+ * - delta: the difference to the previous value, for non-decreasing runs
+ *   such as timestamps and sorted IDs.
+ *
+ * The encoding with the narrower width is picked block by block. A block
+ * index records where each block starts, so single elements are read at
+ * random without decompressing the rest of the array: frame of reference
+ * blocks decode one value, delta blocks add up at most one block of
+ * differences.
+ *
+ * Packed arrays can't be modified; convert back with
+ * cdyar_packed_unpack() to change them.
+ */
+
+#ifndef H_CDYAR_PACKED
+#define H_CDYAR_PACKED
+
+/** @brief Number of elements in one block of a packed array */
+#define CDYAR_PACKED_BLOCK_SIZE 128
+
+#include "./cdyar_darray.h"     //for cdyar_darray and cdyar_resizepolicy
+#include "./cdyar_error.h"      //for cdyar_returncode
+#include "./cdyar_structures.h" //for cdyar_bool and cdyar_flag
+#include <stdint.h>             //for uint64_t
+#include <stdlib.h>             //for size_t
+
+/**
+ * @enum cdyar_packedencoding
+ * @brief How the values of a block are stored
+ */
+typedef enum cdyar_packedencoding {
+  CDYAR_PACKED_FOR = 0,   /**< Value minus the block's minimum */
+  CDYAR_PACKED_DELTA = 1, /**< Difference to the previous value */
+} cdyar_packedencoding;
+
+/**
+ * @struct cdyar_packedblock
+ * @brief Block index entry of a packed array
+ */
+typedef struct cdyar_packedblock {
+  uint64_t base;          /**< Minimum (FOR) or first value (delta) */
+  size_t offset;          /**< Index in data of the block's first word */
+  unsigned char width;    /**< Bits per packed value (0 to 64) */
+  unsigned char encoding; /**< One of cdyar_packedencoding */
+} cdyar_packedblock;
+
+/**
+ * @struct cdyar_packed
+ * @brief Compressed array of integers
+ *
+ * Signed values are stored with their sign bit flipped, which maps them to
+ * unsigned values in the same order.
+ */
+typedef struct cdyar_packed {
+  uint64_t *data;             /**< Bit-packed values of every block */
+  size_t words;               /**< Number of words in data */
+  cdyar_packedblock *blocks;  /**< Block index */
+  size_t length;              /**< Number of elements */
+  size_t typesize;            /**< Size in bytes of each element (4 or 8) */
+  cdyar_bool issigned;        /**< Whether the elements are signed */
+  cdyar_returncode *code;     /**< Pointer to return code for error tracking */
+} cdyar_packed;
+
+/**
+ * @brief Creates a packed copy of a dynamic array of integers
+ *
+ * The dynamic array is left untouched and can be destroyed afterwards to
+ * release its memory.
+ *
+ * @param arr Pointer to the dynamic array (typesize 4 or 8)
+ * @param issigned Whether the elements are signed integers
+ * @param outptr Pointer to cdyar_packed structure to initialize
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if the elements
+ *         are not 4 or 8 bytes wide, or other error code
+ *
+ * @code
+ * cdyar_packed cold;
+ * cdyar_npacked(&timestamps, cdyar_false, &cold);
+ * cdyar_darr(&timestamps);
+ * uint64_t t;
+ * cdyar_packed_get(&cold, 12345, &t);
+ * @endcode
+ */
+cdyar_returncode cdyar_npacked(const cdyar_darray *arr,
+                               const cdyar_bool issigned,
+                               cdyar_packed *outptr);
+
+/**
+ * @brief Destroys a packed array and frees its memory
+ *
+ * @param packed Pointer to the packed array to destroy
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_dpacked(cdyar_packed *packed);
+
+/**
+ * @brief Gets one element of a packed array
+ *
+ * @param packed Pointer to the packed array
+ * @param index Index of the element
+ * @param outptr Pointer to memory where the element (typesize bytes) will
+ *               be stored
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if index is
+ *         out of bounds, or other error code
+ */
+cdyar_returncode cdyar_packed_get(const cdyar_packed *packed,
+                                  const size_t index, void *outptr);
+
+/**
+ * @brief Decompresses a packed array into a new dynamic array
+ *
+ * @param packed Pointer to the packed array
+ * @param policy Resize policy of the new array, or
+ *               CDYAR_DEFAULT_RESIZE_POLICY
+ * @param flags Flags of the new array
+ * @param outptr Pointer to the dynamic array to create
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_packed_unpack(const cdyar_packed *packed,
+                                     const cdyar_resizepolicy policy,
+                                     const cdyar_flag flags,
+                                     cdyar_darray *outptr);
+
+/**
+ * @brief Number of bytes of memory used by a packed array
+ *
+ * @param packed Pointer to the packed array
+ * @param outptr Pointer to where the size (data plus block index) will be
+ *               stored
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_packed_bytes(const cdyar_packed *packed,
+                                    size_t *outptr);
+
+#endif
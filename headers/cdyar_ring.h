@@ -0,0 +1,126 @@
+/**
+ * @file cdyar_ring.h
+ * @brief Circular-buffer dynamic array with O(1) operations at both ends
+ *
+ * A cdyar_ring keeps its elements in a circular buffer that starts at a
+ * head offset, so elements can be pushed and popped at either end without
+ * shifting the rest of the array. This makes it suitable for FIFO queues
+ * and deques. When the buffer is full it doubles in size and the contents
+ * are unwrapped into the new buffer so that the head starts at zero again.
+ */
+
+#ifndef H_CDYAR_RING
+#define H_CDYAR_RING
+
+#include "./cdyar_error.h" //for cdyar_returncode
+#include "./cdyar_types.h" //for cdyar_typehandler
+#include <stdlib.h>        //for size_t
+
+/**
+ * @struct cdyar_ring
+ * @brief Circular-buffer dynamic array
+ *
+ * Logical index i lives at physical slot (head + i) % capacity.
+ */
+typedef struct cdyar_ring {
+  void *elements;            /**< Pointer to the circular buffer */
+  size_t head;               /**< Physical slot of the first element */
+  size_t length;             /**< Number of elements currently in the ring */
+  size_t capacity;           /**< Maximum number of elements the buffer can hold */
+  size_t typesize;           /**< Size in bytes of each element */
+  cdyar_typehandler handler; /**< Function pointer to type handler */
+  cdyar_returncode *code;    /**< Pointer to return code for error tracking */
+} cdyar_ring;
+
+/**
+ * @brief Creates a new ring
+ *
+ * @param typesize Size in bytes of each element
+ * @param capacity Initial capacity (number of elements to allocate space for)
+ * @param handler Type handler function for copying elements
+ * @param outptr Pointer to cdyar_ring structure to initialize
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_nring(const size_t typesize, const size_t capacity,
+                             const cdyar_typehandler handler,
+                             cdyar_ring *outptr);
+
+/**
+ * @brief Destroys a ring and frees its memory
+ *
+ * @param ring Pointer to the ring to destroy
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_dring(cdyar_ring *ring);
+
+/**
+ * @brief Appends an element after the last element of the ring
+ *
+ * @param ring Pointer to the ring
+ * @param valueptr Pointer to the value to copy into the ring
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_ring_pushback(cdyar_ring *ring, void *valueptr);
+
+/**
+ * @brief Prepends an element before the first element of the ring
+ *
+ * The new element becomes index 0 and every other element moves up by
+ * one index, without any data being moved.
+ *
+ * @param ring Pointer to the ring
+ * @param valueptr Pointer to the value to copy into the ring
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_ring_pushfront(cdyar_ring *ring, void *valueptr);
+
+/**
+ * @brief Removes the first element of the ring
+ *
+ * @param ring Pointer to the ring
+ * @param outptr Pointer to memory where the removed element will be
+ *               copied, or NULL to discard it
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if the ring
+ *         is empty, or other error code
+ */
+cdyar_returncode cdyar_ring_popfront(cdyar_ring *ring, void *outptr);
+
+/**
+ * @brief Removes the last element of the ring
+ *
+ * @param ring Pointer to the ring
+ * @param outptr Pointer to memory where the removed element will be
+ *               copied, or NULL to discard it
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if the ring
+ *         is empty, or other error code
+ */
+cdyar_returncode cdyar_ring_popback(cdyar_ring *ring, void *outptr);
+
+/**
+ * @brief Sets an element at the specified index, relative to the head
+ *
+ * Follows the rules of cdyar_set: index may replace an existing element or
+ * be equal to the length, in which case the value is pushed at the back.
+ *
+ * @param ring Pointer to the ring
+ * @param index Index of the element, counted from the first element
+ * @param valueptr Pointer to the value to copy into the ring
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if index is
+ *         past the end, or other error code
+ */
+cdyar_returncode cdyar_ring_set(cdyar_ring *ring, const size_t index,
+                                void *valueptr);
+
+/**
+ * @brief Gets an element at the specified index, relative to the head
+ *
+ * @param ring Pointer to the ring
+ * @param index Index of the element, counted from the first element
+ * @param outptr Pointer to memory where the element will be copied
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if index is
+ *         out of bounds, or other error code
+ */
+cdyar_returncode cdyar_ring_get(const cdyar_ring *ring, const size_t index,
+                                void *outptr);
+
+#endif
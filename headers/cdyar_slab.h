@@ -0,0 +1,112 @@
+/**
+ * @file cdyar_slab.h
+ * @brief Slab allocator for dynamic array headers
+ *
+ * Creating an array with NEW_CDYAR_ONHEAP costs three allocations: the
+ * cdyar_darray structure, its elements buffer and its return code. A slab
+ * hands out cdyar_darray structures from large preallocated chunks and
+ * recycles them through a free list, and the arrays it creates keep their
+ * return code inside the structure (CDYAR_ARR_INLINE_CODE). Each array
+ * then costs a single allocation for its data.
+ *
+ * A slab is not thread-safe; use one slab per thread.
+ */
+
+#ifndef H_CDYAR_SLAB
+#define H_CDYAR_SLAB
+
+/** @brief Default number of array headers allocated per chunk */
+#define CDYAR_SLAB_DEFAULT_CHUNK 64
+
+#include "./cdyar_darray.h" //for cdyar_darray and cdyar_narr's parameters
+#include "./cdyar_error.h"  //for cdyar_returncode
+#include <stdlib.h>         //for size_t
+
+/**
+ * @union cdyar_slabnode
+ * @brief One slot of a slab: an array header, or a free list link
+ */
+typedef union cdyar_slabnode {
+  cdyar_darray arr;             /**< Array header while the slot is in use */
+  union cdyar_slabnode *next;   /**< Next free slot while the slot is free */
+} cdyar_slabnode;
+
+/**
+ * @struct cdyar_slabchunk
+ * @brief Block of slots allocated at once
+ */
+typedef struct cdyar_slabchunk {
+  struct cdyar_slabchunk *next; /**< Previously allocated chunk */
+  cdyar_slabnode nodes[];       /**< The chunk's slots */
+} cdyar_slabchunk;
+
+/**
+ * @struct cdyar_slab
+ * @brief Pool of reusable dynamic array headers
+ */
+typedef struct cdyar_slab {
+  cdyar_slabchunk *chunks;  /**< List of every chunk allocated so far */
+  cdyar_slabnode *freelist; /**< Slots available for new arrays */
+  size_t chunksize;         /**< Number of slots per chunk */
+  size_t live;              /**< Number of arrays currently handed out */
+} cdyar_slab;
+
+/**
+ * @brief Creates a new slab
+ *
+ * No memory is allocated until the first array is created.
+ *
+ * @param chunksize Number of array headers allocated per chunk, e.g.
+ *                  CDYAR_SLAB_DEFAULT_CHUNK
+ * @param outptr Pointer to cdyar_slab structure to initialize
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_nslab(const size_t chunksize, cdyar_slab *outptr);
+
+/**
+ * @brief Destroys a slab and frees all of its chunks
+ *
+ * Every array created from the slab must have been destroyed with
+ * cdyar_slab_darr() first.
+ *
+ * @param slab Pointer to the slab to destroy
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if arrays from
+ *         the slab are still alive, or other error code
+ */
+cdyar_returncode cdyar_dslab(cdyar_slab *slab);
+
+/**
+ * @brief Creates a new dynamic array whose header comes from a slab
+ *
+ * Takes the same parameters as cdyar_narr(). CDYAR_ARR_INLINE_CODE is
+ * always added to flags, so the array's return code lives in its header.
+ *
+ * @param slab Pointer to the slab
+ * @param typesize Size in bytes of each element
+ * @param capacity Initial capacity (number of elements to allocate space for)
+ * @param policy Resize policy function, or CDYAR_DEFAULT_RESIZE_POLICY for default
+ * @param handler Type handler function for copying elements
+ * @param flags Binary flags controlling array behavior (see cdyar_darray_binflags)
+ * @param outptr Pointer to where the pointer to the new array will be stored
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_slab_narr(cdyar_slab *slab, const size_t typesize,
+                                 const size_t capacity,
+                                 const cdyar_resizepolicy policy,
+                                 const cdyar_typehandler handler,
+                                 const cdyar_flag flags,
+                                 cdyar_darray **outptr);
+
+/**
+ * @brief Destroys a dynamic array created from a slab
+ *
+ * The array's data is freed with cdyar_darr() and its header goes back to
+ * the slab's free list for reuse.
+ *
+ * @param slab Pointer to the slab the array was created from
+ * @param arr Pointer to the dynamic array to destroy
+ * @return The result of cdyar_darr() on the array, or an error code
+ */
+cdyar_returncode cdyar_slab_darr(cdyar_slab *slab, cdyar_darray *arr);
+
+#endif
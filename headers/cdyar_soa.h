@@ -0,0 +1,180 @@
+/**
+ * @file cdyar_soa.h
+ * @brief Structure-of-arrays container for struct elements
+ *
+ * A cdyar_soa stores records field by field: every field described in the
+ * layout gets its own contiguous column. Scans over a single field then
+ * only touch the memory of that field instead of whole records. Records
+ * are still set and read whole, and all columns grow together under one
+ * resize policy.
+ */
+
+#ifndef H_CDYAR_SOA
+#define H_CDYAR_SOA
+
+/** @brief Default SoA resize policy (NULL uses internal default behavior) */
+#define CDYAR_SOA_DEFAULT_RESIZE_POLICY NULL
+
+#include "./cdyar_error.h"      //for cdyar_returncode
+#include "./cdyar_structures.h" //for cdyar_bool
+#include <stddef.h>             //for offsetof
+#include <stdlib.h>             //for size_t
+
+/**
+ * @brief Builds a cdyar_soa_field describing a member of a struct
+ *
+ * @param type The record type (e.g., struct MyStruct)
+ * @param member Name of the member inside the record type
+ *
+ * @code
+ * cdyar_soa_field layout[] = {CDYAR_SOA_FIELD(mycoolstruct, x),
+ *                             CDYAR_SOA_FIELD(mycoolstruct, y)};
+ * @endcode
+ */
+#define CDYAR_SOA_FIELD(type, member)                                          \
+  { offsetof(type, member), sizeof(((type *)0)->member) }
+
+/**
+ * @struct cdyar_soa_field
+ * @brief Location of one field inside a record
+ */
+typedef struct cdyar_soa_field {
+  size_t offset; /**< Offset in bytes of the field inside the record */
+  size_t size;   /**< Size in bytes of the field */
+} cdyar_soa_field;
+
+struct cdyar_soa;
+
+/**
+ * @typedef cdyar_soa_resizepolicy
+ * @brief Function pointer type for SoA resize policy implementations
+ *
+ * Works like cdyar_resizepolicy, except that a policy must grow every
+ * column of the container and update its capacity once all of them have
+ * been grown.
+ *
+ * @param soa Pointer to the SoA container to resize
+ * @param code Pointer to return code for error reporting
+ */
+typedef void (*cdyar_soa_resizepolicy)(struct cdyar_soa *soa,
+                                       cdyar_returncode *code);
+
+/**
+ * @struct cdyar_soa
+ * @brief Structure-of-arrays container
+ */
+typedef struct cdyar_soa {
+  void **columns;                /**< One data buffer per field */
+  cdyar_soa_field *fields;       /**< Copy of the field layout */
+  size_t fieldcount;             /**< Number of fields (and columns) */
+  size_t recordsize;             /**< Size in bytes of a whole record */
+  size_t length;                 /**< Number of records currently stored */
+  size_t capacity;               /**< Number of records every column can hold */
+  cdyar_soa_resizepolicy policy; /**< Function pointer to resize policy */
+  cdyar_returncode *code;        /**< Pointer to return code for error tracking */
+} cdyar_soa;
+
+/**
+ * @brief Creates a new structure-of-arrays container
+ *
+ * The layout is copied, so the fields array does not need to outlive the
+ * call. Every field must lie entirely inside a record of recordsize bytes.
+ *
+ * @param fields Array describing each field of a record
+ * @param fieldcount Number of entries in fields
+ * @param recordsize Size in bytes of a whole record (e.g., sizeof(struct))
+ * @param capacity Initial capacity in records
+ * @param policy Resize policy function, or CDYAR_SOA_DEFAULT_RESIZE_POLICY
+ * @param outptr Pointer to cdyar_soa structure to initialize
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_nsoa(const cdyar_soa_field *fields,
+                            const size_t fieldcount, const size_t recordsize,
+                            const size_t capacity,
+                            const cdyar_soa_resizepolicy policy,
+                            cdyar_soa *outptr);
+
+/**
+ * @brief Destroys a structure-of-arrays container and frees its memory
+ *
+ * @param soa Pointer to the container to destroy
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_dsoa(cdyar_soa *soa);
+
+/**
+ * @brief Stores a whole record at the specified index
+ *
+ * Follows the rules of cdyar_set: index may replace an existing record or
+ * append right after the last one, growing every column if needed.
+ *
+ * @param soa Pointer to the container
+ * @param index Index where the record should be stored
+ * @param recordptr Pointer to the record to scatter into the columns
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if index is
+ *         past the end, or other error code
+ */
+cdyar_returncode cdyar_soa_set(cdyar_soa *soa, const size_t index,
+                               const void *recordptr);
+
+/**
+ * @brief Reads a whole record at the specified index
+ *
+ * Gathers every field of the record into outptr. Bytes of the record that
+ * are not covered by any field (padding) are left untouched.
+ *
+ * @param soa Pointer to the container
+ * @param index Index of the record to read
+ * @param outptr Pointer to memory where the record will be assembled
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if index is
+ *         out of bounds, or other error code
+ */
+cdyar_returncode cdyar_soa_get(const cdyar_soa *soa, const size_t index,
+                               void *outptr);
+
+/**
+ * @brief Removes the record at the specified index
+ *
+ * Records after index are shifted one step to the left in every column.
+ *
+ * @param soa Pointer to the container
+ * @param index Index of the record to remove
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if index is out
+ *         of bounds, or other error code
+ */
+cdyar_returncode cdyar_soa_rm(cdyar_soa *soa, const size_t index);
+
+/**
+ * @brief Gets a direct pointer to the column of a field
+ *
+ * The column holds soa->length values of fields[field].size bytes each,
+ * packed back to back. The pointer is invalidated by any resize.
+ *
+ * @param soa Pointer to the container
+ * @param field Index of the field in the layout given at creation
+ * @param outptr Pointer to where the column pointer will be stored
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if field does
+ *         not exist, or other error code
+ *
+ * @code
+ * int *xs;
+ * cdyar_soa_column(&soa, 0, (void **)&xs);
+ * for (size_t i = 0; i < soa.length; i++) {
+ *     sum += xs[i];
+ * }
+ * @endcode
+ */
+cdyar_returncode cdyar_soa_column(const cdyar_soa *soa, const size_t field,
+                                  void **outptr);
+
+/**
+ * @brief Sets the resize policy for a structure-of-arrays container
+ *
+ * @param soa Pointer to the container
+ * @param policy New resize policy function pointer
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_soa_setpolicy(cdyar_soa *soa,
+                                     const cdyar_soa_resizepolicy policy);
+
+#endif
@@ -0,0 +1,130 @@
+/**
+ * @file cdyar_sparse.h
+ * @brief Sparse arrays for large, mostly-empty index spaces
+ *
+ * A cdyar_darray only accepts writes up to its length, so an array indexed
+ * by, say, 64-bit IDs has to be filled densely up to the largest ID. A
+ * cdyar_sparse accepts any index instead. Its elements are stored in pages
+ * of CDYAR_SPARSE_PAGE_SIZE slots that are allocated on their first write,
+ * with a bitmap of the slots of a page that hold an element. Pages are
+ * found through an open-addressing hash table keyed by page number, so
+ * memory scales with the number of occupied pages rather than with the
+ * highest index.
+ *
+ * Reading a slot that was never written (or was removed) yields zeros, the
+ * same as reading unused capacity of a cdyar_darray.
+ */
+
+#ifndef H_CDYAR_SPARSE
+#define H_CDYAR_SPARSE
+
+/** @brief Number of element slots in one page (one bit each in its bitmap) */
+#define CDYAR_SPARSE_PAGE_SIZE 64
+
+#include "./cdyar_error.h"      //for cdyar_returncode
+#include "./cdyar_structures.h" //for cdyar_bool
+#include "./cdyar_types.h"      //for cdyar_typehandler
+#include <stdint.h>             //for uint64_t
+#include <stdlib.h>             //for size_t
+
+/**
+ * @struct cdyar_sparsepage
+ * @brief Block of CDYAR_SPARSE_PAGE_SIZE consecutive slots
+ */
+typedef struct cdyar_sparsepage {
+  size_t number;            /**< Page number (index / CDYAR_SPARSE_PAGE_SIZE) */
+  uint64_t present;         /**< Bit i is set if slot i holds an element */
+  unsigned char elements[]; /**< Storage for the slots of the page */
+} cdyar_sparsepage;
+
+/**
+ * @struct cdyar_sparse
+ * @brief Sparse array with pages allocated on demand
+ */
+typedef struct cdyar_sparse {
+  cdyar_sparsepage **pages;  /**< Hash table of pages, NULL for empty slots */
+  size_t slotcount;          /**< Number of slots in pages (a power of two) */
+  size_t pagecount;          /**< Number of allocated pages */
+  size_t count;              /**< Number of elements present */
+  size_t typesize;           /**< Size in bytes of each element */
+  cdyar_typehandler handler; /**< Function pointer to type handler */
+  cdyar_returncode *code;    /**< Pointer to return code for error tracking */
+} cdyar_sparse;
+
+/**
+ * @brief Creates a new, empty sparse array
+ *
+ * @param typesize Size in bytes of each element
+ * @param handler Type handler function for copying elements
+ * @param outptr Pointer to cdyar_sparse structure to initialize
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_nsparse(const size_t typesize,
+                               const cdyar_typehandler handler,
+                               cdyar_sparse *outptr);
+
+/**
+ * @brief Destroys a sparse array and frees its pages
+ *
+ * @param sparse Pointer to the sparse array to destroy
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_dsparse(cdyar_sparse *sparse);
+
+/**
+ * @brief Sets the element at any index
+ *
+ * Unlike cdyar_set, index is not limited by a length. The page holding
+ * index is allocated (zero-filled) if this is its first element.
+ *
+ * @param sparse Pointer to the sparse array
+ * @param index Index of the element
+ * @param valueptr Pointer to the value to copy into the array
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ *
+ * @code
+ * cdyar_sparse users;
+ * cdyar_nsparse(sizeof(user), cdyar_generic_typehandler, &users);
+ * cdyar_sparse_set(&users, 9000000001, &alice); // allocates a single page
+ * @endcode
+ */
+cdyar_returncode cdyar_sparse_set(cdyar_sparse *sparse, const size_t index,
+                                  void *valueptr);
+
+/**
+ * @brief Gets the element at any index
+ *
+ * @param sparse Pointer to the sparse array
+ * @param index Index of the element
+ * @param outptr Pointer to memory where the element will be copied. It is
+ *               zero-filled if no element is present at index.
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_sparse_get(const cdyar_sparse *sparse,
+                                  const size_t index, void *outptr);
+
+/**
+ * @brief Checks whether an element is present at an index
+ *
+ * @param sparse Pointer to the sparse array
+ * @param index Index to check
+ * @param outptr Pointer to where the result will be stored
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_sparse_has(const cdyar_sparse *sparse,
+                                  const size_t index, cdyar_bool *outptr);
+
+/**
+ * @brief Removes the element at an index
+ *
+ * The slot reads as zeros afterwards. A page is freed as soon as its last
+ * element is removed. Other indices are not shifted.
+ *
+ * @param sparse Pointer to the sparse array
+ * @param index Index of the element to remove
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if no element
+ *         is present at index, or other error code
+ */
+cdyar_returncode cdyar_sparse_rm(cdyar_sparse *sparse, const size_t index);
+
+#endif
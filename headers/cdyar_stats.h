@@ -0,0 +1,128 @@
+/**
+ * @file cdyar_stats.h
+ * @brief Opt-in performance counters for dynamic arrays
+ *
+ * When the library is built with CDYAR_STATS defined (make STATS=1), every
+ * dynamic array counts its resizes, accesses, handler invocations and
+ * element shifts, and the same counters are aggregated across all arrays.
+ * Without CDYAR_STATS the counters are compiled out entirely and cost
+ * nothing. Code that includes the cdyar headers must agree with the
+ * library on CDYAR_STATS, since it changes the layout of cdyar_darray.
+ */
+
+#ifndef H_CDYAR_STATS
+#define H_CDYAR_STATS
+
+#include "./cdyar_error.h"      //for cdyar_returncode and cdyar_darray
+#include "./cdyar_structures.h"
+#include <stdatomic.h>          //for the global counters
+#include <stdio.h>              //for FILE
+#include <stdlib.h>             //for size_t
+
+/**
+ * @struct cdyar_stats
+ * @brief Counters describing how a dynamic array has been used
+ */
+typedef struct cdyar_stats {
+  size_t resizes;       /**< Number of times the resize policy grew the array */
+  size_t resize_bytes;  /**< Bytes of elements carried over by those resizes */
+  size_t peak_capacity; /**< Largest capacity reached, in elements */
+  size_t sets;          /**< Number of cdyar_set calls */
+  size_t gets;          /**< Number of cdyar_get calls */
+  size_t rms;           /**< Number of cdyar_rm and cdyar_swaprm calls */
+  size_t handler_calls; /**< Number of type handler invocations */
+  size_t shift_moves;   /**< Elements moved by left shifts during removals */
+} cdyar_stats;
+
+#ifdef CDYAR_STATS
+
+/**
+ * @struct cdyar_globalstats
+ * @brief Counters aggregated across every dynamic array
+ *
+ * Updated atomically so arrays living on different threads can all
+ * contribute. Read it through cdyar_getglobalstats().
+ */
+typedef struct cdyar_globalstats {
+  atomic_size_t resizes;       /**< See cdyar_stats::resizes */
+  atomic_size_t resize_bytes;  /**< See cdyar_stats::resize_bytes */
+  atomic_size_t peak_capacity; /**< Largest capacity reached by any array */
+  atomic_size_t sets;          /**< See cdyar_stats::sets */
+  atomic_size_t gets;          /**< See cdyar_stats::gets */
+  atomic_size_t rms;           /**< See cdyar_stats::rms */
+  atomic_size_t handler_calls; /**< See cdyar_stats::handler_calls */
+  atomic_size_t shift_moves;   /**< See cdyar_stats::shift_moves */
+} cdyar_globalstats;
+
+/** @brief Aggregate counters, updated alongside every array's own */
+extern cdyar_globalstats cdyar_global_stats;
+
+/**
+ * @brief Adds to one counter of an array and to the aggregate counter
+ *
+ * Used internally by the library; compiles to nothing without CDYAR_STATS.
+ */
+#define CDYAR_STAT_ADD(arr, field, amount)                                     \
+  do {                                                                         \
+    (arr)->stats.field += (amount);                                            \
+    atomic_fetch_add_explicit(&cdyar_global_stats.field, (amount),             \
+                              memory_order_relaxed);                           \
+  } while (0)
+
+/**
+ * @brief Records the current capacity of an array as a candidate peak
+ *
+ * Used internally by the library; compiles to nothing without CDYAR_STATS.
+ */
+#define CDYAR_STAT_PEAK(arr) cdyar_stats_notepeak(arr)
+
+/**
+ * @brief Updates the peak capacity counters of an array (internal use)
+ *
+ * @param arr Pointer to the dynamic array
+ */
+void cdyar_stats_notepeak(cdyar_darray *arr);
+
+#else
+
+#define CDYAR_STAT_ADD(arr, field, amount) ((void)0)
+#define CDYAR_STAT_PEAK(arr) ((void)0)
+
+#endif
+
+/**
+ * @brief Reads the counters of a dynamic array
+ *
+ * @param arr Pointer to the dynamic array
+ * @param outptr Pointer to where the counters will be copied
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_FAILED if the library was
+ *         built without CDYAR_STATS (outptr is then zeroed), or other
+ *         error code
+ */
+cdyar_returncode cdyar_getstats(const cdyar_darray *arr, cdyar_stats *outptr);
+
+/**
+ * @brief Reads the counters aggregated across every dynamic array
+ *
+ * The peak capacity is the largest capacity any single array reached.
+ *
+ * @param outptr Pointer to where the counters will be copied
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_FAILED if the library was
+ *         built without CDYAR_STATS (outptr is then zeroed), or other
+ *         error code
+ */
+cdyar_returncode cdyar_getglobalstats(cdyar_stats *outptr);
+
+/**
+ * @brief Prints the counters of a dynamic array
+ *
+ * Counterpart of cdyar_printstatus() for performance counters.
+ *
+ * @param arr Pointer to the dynamic array, or NULL for the aggregate
+ *            counters of every array
+ * @param destination File stream where the counters will be written
+ * @return CDYAR_SUCCESSFUL on success, error code on failure
+ */
+cdyar_returncode cdyar_printstats(const cdyar_darray *arr, FILE *destination);
+
+#endif
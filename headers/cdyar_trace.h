@@ -0,0 +1,150 @@
+/**
+ * @file cdyar_trace.h
+ * @brief Operation traces of dynamic arrays and their replay
+ *
+ * A trace attached to a cdyar_darray records every operation performed on
+ * it to a compact binary log: the array's creation, each successful
+ * cdyar_set, cdyar_get, cdyar_rm and cdyar_swaprm, each resize and its
+ * destruction. cdyar_replay runs a recorded log against any resize policy,
+ * alignment and flags, so policies and allocator settings can be tuned
+ * against real workloads. The
+ * cdyar_replay tool ('make replay') does this from the command line.
+ *
+ * The log starts with the four bytes "CDYT" and a version byte. Every
+ * event is then one opcode byte (see cdyar_traceop) followed by its
+ * arguments as unsigned LEB128 varints:
+ * - CDYAR_TRACE_CREATE: typesize, capacity, length
+ * - CDYAR_TRACE_SET, _GET, _RM, _SWAPRM: index
+ * - CDYAR_TRACE_RESIZE: old capacity, new capacity
+ * - CDYAR_TRACE_DESTROY: none
+ *
+ * Element values are not recorded.
+ */
+
+#ifndef H_CDYAR_TRACE
+#define H_CDYAR_TRACE
+
+/** @brief Version of the trace format written by this library */
+#define CDYAR_TRACE_VERSION 1
+
+/** @brief Size in bytes of the buffer events are collected in before writing */
+#define CDYAR_TRACE_BUFFER 4096
+
+#include "./cdyar_darray.h" //for cdyar_darray and cdyar_resizepolicy
+#include "./cdyar_error.h"  //for cdyar_returncode
+#include "./cdyar_structures.h" //for cdyar_bool and cdyar_flag
+#include <stdio.h>          //for FILE
+#include <stdlib.h>         //for size_t
+
+/**
+ * @enum cdyar_traceop
+ * @brief Opcodes of the events of a trace
+ */
+typedef enum cdyar_traceop {
+  CDYAR_TRACE_CREATE = 1, /**< Array created (or trace attached) */
+  CDYAR_TRACE_SET,        /**< Element replaced or appended */
+  CDYAR_TRACE_GET,        /**< Element read */
+  CDYAR_TRACE_RM,         /**< Element removed, order preserved */
+  CDYAR_TRACE_SWAPRM,     /**< Element removed by swapping in the last one */
+  CDYAR_TRACE_RESIZE,     /**< Capacity changed */
+  CDYAR_TRACE_DESTROY,    /**< Array destroyed (or trace detached) */
+} cdyar_traceop;
+
+/**
+ * @struct cdyar_trace
+ * @brief Recording state of a trace attached to an array
+ */
+typedef struct cdyar_trace {
+  FILE *destination;                        /**< Stream the log is written to */
+  size_t used;                              /**< Bytes waiting in buffer */
+  cdyar_bool failed;                        /**< Whether a write has failed */
+  unsigned char buffer[CDYAR_TRACE_BUFFER]; /**< Events not yet written */
+} cdyar_trace;
+
+/**
+ * @struct cdyar_replayresult
+ * @brief Measurements taken while replaying a trace
+ */
+typedef struct cdyar_replayresult {
+  size_t operations;   /**< Number of set, get and removal events replayed */
+  size_t failures;     /**< Events the replayed array rejected */
+  size_t resizes;      /**< Number of times the replayed array grew */
+  size_t copied_bytes; /**< Bytes carried over by resizes and removal shifts */
+  size_t peak_bytes;   /**< Largest element storage, counting both buffers
+                            while a resize copies from one to the other */
+  double seconds;      /**< Wall-clock time spent replaying */
+} cdyar_replayresult;
+
+/**
+ * @brief Starts recording the operations performed on an array
+ *
+ * A CDYAR_TRACE_CREATE event describing the array's current typesize,
+ * capacity and length is written first. The stream is not closed by the
+ * library.
+ *
+ * @param arr Pointer to the dynamic array
+ * @param destination Binary stream the log is written to
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if a trace is
+ *         already attached or destination is NULL, or other error code
+ *
+ * @code
+ * FILE *log = fopen("requests.cdyt", "wb");
+ * cdyar_attachtrace(&requests, log);
+ * // ... run the workload ...
+ * cdyar_darr(&requests); // records the end of the trace
+ * fclose(log);
+ * @endcode
+ */
+cdyar_returncode cdyar_attachtrace(cdyar_darray *arr, FILE *destination);
+
+/**
+ * @brief Stops recording and flushes the trace of an array
+ *
+ * Writes a CDYAR_TRACE_DESTROY event. cdyar_darr() detaches the trace
+ * automatically.
+ *
+ * @param arr Pointer to the dynamic array
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_FAILED if any part of the log
+ *         could not be written, or other error code
+ */
+cdyar_returncode cdyar_detachtrace(cdyar_darray *arr);
+
+/**
+ * @brief Records an event in the trace of an array (internal use)
+ *
+ * Events are buffered; write failures are remembered and reported by
+ * cdyar_detachtrace() so that recording never changes the outcome of the
+ * traced operation.
+ *
+ * @param trace Pointer to the trace
+ * @param op Opcode of the event
+ * @param first First argument (ignored by events without arguments)
+ * @param second Second argument (only used by CDYAR_TRACE_RESIZE)
+ */
+void cdyar_trace_record(cdyar_trace *trace, const cdyar_traceop op,
+                        const size_t first, const size_t second);
+
+/**
+ * @brief Replays a recorded trace against a resize policy
+ *
+ * The whole log is decoded before the clock starts, so only the array
+ * operations are timed. Elements are zero-filled. Events the replayed
+ * array rejects (for instance a get past a smaller capacity) are counted
+ * in failures and skipped. Only the first array of the log is replayed.
+ *
+ * @param source Binary stream positioned at the start of a trace
+ * @param policy Resize policy to replay with, or CDYAR_DEFAULT_RESIZE_POLICY
+ * @param alignment Alignment of the replayed array's buffer (see
+ *                  cdyar_narr_aligned()), or CDYAR_DEFAULT_ALIGNMENT
+ * @param flags Flags to create the replayed array with
+ * @param outptr Pointer to where the measurements will be stored
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if the stream
+ *         is not a valid trace or alignment is not a power of two, or other
+ *         error code
+ */
+cdyar_returncode cdyar_replay(FILE *source, const cdyar_resizepolicy policy,
+                              const size_t alignment,
+                              const cdyar_flag flags,
+                              cdyar_replayresult *outptr);
+
+#endif
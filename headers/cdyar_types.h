@@ -94,6 +94,91 @@ why -> replacd CDYAR_DEFINE_TYPE_HANDLER specific-type, typehandler function gen
 typedef void (*cdyar_typehandler)(void *left_voidptr, void *right_voidptr,
                                   cdyar_flag direction, size_t size, cdyar_returncode *code);
 
+/**
+ * @typedef cdyar_comparator
+ * @brief Function pointer type for ordering two elements
+ *
+ * Follows the qsort convention: returns a negative value if the left
+ * element orders before the right one, zero if they are equivalent and a
+ * positive value otherwise.
+ *
+ * @param left_voidptr Pointer to the left element
+ * @param right_voidptr Pointer to the right element
+ * @return Negative, zero or positive value as described above
+ */
+typedef int (*cdyar_comparator)(const void *left_voidptr,
+                                const void *right_voidptr);
+
+/**
+ * @typedef cdyar_reducer
+ * @brief Function pointer type for combining two equivalent elements
+ *
+ * Folds the duplicate into the element that is kept, for example by adding
+ * up counters. The duplicate is dropped afterwards.
+ *
+ * @param kept_voidptr Pointer to the element that stays
+ * @param duplicate_voidptr Pointer to the element being dropped
+ * @param size Size in bytes of the elements
+ */
+typedef void (*cdyar_reducer)(void *kept_voidptr,
+                              const void *duplicate_voidptr, size_t size);
+
+/**
+ * @typedef cdyar_copyhook
+ * @brief Function pointer type for deep-copying an element
+ *
+ * Copies the element at src into the uninitialized memory at dst,
+ * duplicating every resource the element owns (heap strings, buffers...).
+ *
+ * @param dst Pointer to the memory receiving the copy
+ * @param src Pointer to the element to copy
+ * @param size Size in bytes of the element
+ * @param code Pointer to return code, set to CDYAR_SUCCESSFUL or to an
+ *             error code (dst is then left uninitialized)
+ */
+typedef void (*cdyar_copyhook)(void *dst, const void *src, size_t size,
+                               cdyar_returncode *code);
+
+/**
+ * @typedef cdyar_movehook
+ * @brief Function pointer type for relocating an element
+ *
+ * Moves the element at src into the uninitialized memory at dst. Afterwards
+ * src is considered uninitialized and is not destroyed. Only needed for
+ * elements that can't be moved with memcpy, such as structs pointing into
+ * themselves.
+ *
+ * @param dst Pointer to the memory receiving the element
+ * @param src Pointer to the element to move
+ * @param size Size in bytes of the element
+ */
+typedef void (*cdyar_movehook)(void *dst, void *src, size_t size);
+
+/**
+ * @typedef cdyar_destroyhook
+ * @brief Function pointer type for releasing the resources of an element
+ *
+ * @param element Pointer to the element to destroy
+ * @param size Size in bytes of the element
+ */
+typedef void (*cdyar_destroyhook)(void *element, size_t size);
+
+/**
+ * @struct cdyar_typedesc
+ * @brief Lifecycle hooks of an element type
+ *
+ * Every hook is optional. Without a copy hook elements are copied with the
+ * array's type handler, without a destroy hook removing an element does
+ * nothing, and relocatable elements are moved with memcpy and memmove
+ * (whole ranges at once) instead of the move hook.
+ */
+typedef struct cdyar_typedesc {
+  cdyar_copyhook copy;       /**< Deep copy (NULL to use the type handler) */
+  cdyar_movehook move;       /**< Relocation (only used if not relocatable) */
+  cdyar_destroyhook destroy; /**< Destructor (NULL if nothing to release) */
+  cdyar_bool relocatable;    /**< Whether elements can be moved bitwise */
+} cdyar_typedesc;
+
 /**
  * @brief Generic type handler implementation using memcpy
  * 
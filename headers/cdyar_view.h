@@ -0,0 +1,285 @@
+/**
+ * @file cdyar_view.h
+ * @brief Zero-copy slices, strided views and 2-D views of dynamic arrays
+ *
+ * A view describes elements that already live in some buffer by a base
+ * pointer, a length, an element size and a stride in bytes. Views are
+ * created from a range of a dynamic array, from every n-th element of it,
+ * or from one field of its struct elements, and can be sliced further.
+ * Passing a view to a function hands over a sub-range without copying it
+ * into a new array.
+ *
+ * Views own nothing and don't need to be destroyed. Like cursors, they
+ * become invalid as soon as the array they were created from is resized,
+ * destroyed or has elements removed. Elements are copied in and out of
+ * views with memcpy, not through the array's type handler, and sorted by
+ * swapping their bytes. Views can therefore not be created from arrays
+ * whose type descriptor (see cdyar_settype()) has a destroy hook or is not
+ * relocatable; CDYAR_INVALID_INPUT is returned for those.
+ *
+ * Creating a view unshares the array's buffer first (see cdyar_unshare()),
+ * so writing through a view, sorting it or writing through one of its
+ * cursors never changes a clone. Those writes do bypass attached hash
+ * indexes; call cdyar_rebuildindex() after modifying indexed elements
+ * through a view.
+ *
+ * A cdyar_view2d describes a row-major matrix stored in one array. Its
+ * rows, columns and rectangular blocks are views of their own, and it can
+ * be transposed by swapping its strides.
+ */
+
+#ifndef H_CDYAR_VIEW
+#define H_CDYAR_VIEW
+
+#include "./cdyar_cursor.h" //for cdyar_cursor
+#include "./cdyar_darray.h" //for cdyar_darray
+#include "./cdyar_error.h"  //for cdyar_returncode
+#include "./cdyar_types.h"  //for cdyar_comparator
+#include <stddef.h>         //for ptrdiff_t
+#include <stdlib.h>         //for size_t
+
+/**
+ * @struct cdyar_view
+ * @brief Non-owning view of elements spaced a fixed distance apart
+ *
+ * Element i lives at base + i * stride. The stride may be larger than the
+ * element size (strided columns, struct fields) or negative (reversed
+ * views).
+ */
+typedef struct cdyar_view {
+  char *base;       /**< Pointer to the first element */
+  size_t length;    /**< Number of elements in the view */
+  size_t typesize;  /**< Size in bytes of each element */
+  ptrdiff_t stride; /**< Distance in bytes between two consecutive elements */
+} cdyar_view;
+
+/**
+ * @struct cdyar_view2d
+ * @brief Non-owning view of a matrix
+ *
+ * Element (row, col) lives at base + row * rowstride + col * colstride.
+ */
+typedef struct cdyar_view2d {
+  char *base;          /**< Pointer to element (0, 0) */
+  size_t rows;         /**< Number of rows */
+  size_t cols;         /**< Number of columns */
+  size_t typesize;     /**< Size in bytes of each element */
+  ptrdiff_t rowstride; /**< Distance in bytes between two rows */
+  ptrdiff_t colstride; /**< Distance in bytes between two columns */
+} cdyar_view2d;
+
+/**
+ * @brief Creates a view of a contiguous range of a dynamic array
+ *
+ * An incremental resize in progress is completed first (see
+ * cdyar_finishresize()).
+ *
+ * @param arr Pointer to the dynamic array
+ * @param start Index of the first element of the view
+ * @param length Number of elements in the view
+ * @param outptr Pointer to the view to initialize
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if the range
+ *         doesn't fit in the array's length, or other error code
+ *
+ * @code
+ * cdyar_view half;
+ * cdyar_nview(&samples, 0, samples.length / 2, &half);
+ * worker(&half); // no copy
+ * @endcode
+ */
+cdyar_returncode cdyar_nview(cdyar_darray *arr, const size_t start,
+                             const size_t length, cdyar_view *outptr);
+
+/**
+ * @brief Creates a view of every step-th element of a dynamic array
+ *
+ * The view starts at index start and takes elements step apart for as
+ * long as they are inside the array, so that column c of a row-major
+ * matrix with n columns is cdyar_nview_strided(arr, c, n, &column).
+ *
+ * @param arr Pointer to the dynamic array
+ * @param start Index of the first element of the view
+ * @param step Number of elements between two elements of the view (must
+ *             be positive)
+ * @param outptr Pointer to the view to initialize
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if start is
+ *         past the end, or other error code
+ */
+cdyar_returncode cdyar_nview_strided(cdyar_darray *arr, const size_t start,
+                                     const size_t step, cdyar_view *outptr);
+
+/**
+ * @brief Creates a view of one field of every struct element of an array
+ *
+ * @param arr Pointer to the dynamic array
+ * @param offset Offset of the field inside an element (use offsetof)
+ * @param fieldsize Size in bytes of the field
+ * @param outptr Pointer to the view to initialize
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_INVALID_INPUT if the field
+ *         doesn't fit inside an element, or other error code
+ *
+ * @code
+ * cdyar_view prices;
+ * cdyar_nview_field(&items, offsetof(item, price), sizeof(double), &prices);
+ * @endcode
+ */
+cdyar_returncode cdyar_nview_field(cdyar_darray *arr, const size_t offset,
+                                   const size_t fieldsize, cdyar_view *outptr);
+
+/**
+ * @brief Creates a view of part of another view
+ *
+ * @param view Pointer to the view to slice
+ * @param start Index (in view) of the first element of the slice
+ * @param length Number of elements in the slice
+ * @param step Number of elements of view between two elements of the
+ *             slice; negative steps walk backwards from start
+ * @param outptr Pointer to the view to initialize (may be view itself)
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if the slice
+ *         leaves view, CDYAR_INVALID_INPUT if step is 0, or other error code
+ */
+cdyar_returncode cdyar_view_slice(const cdyar_view *view, const size_t start,
+                                  const size_t length, const ptrdiff_t step,
+                                  cdyar_view *outptr);
+
+/**
+ * @brief Pointer to an element of a view, without bounds checking
+ *
+ * @param view Pointer to the view
+ * @param index Index of the element, smaller than the view's length
+ * @return Pointer to the element inside the viewed buffer
+ */
+static inline void *cdyar_view_at(const cdyar_view *view, const size_t index) {
+  return view->base + ((ptrdiff_t)index * view->stride);
+}
+
+/**
+ * @brief Gets an element of a view
+ *
+ * @param view Pointer to the view
+ * @param index Index of the element
+ * @param outptr Pointer to memory where the element will be copied
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if index is
+ *         out of bounds, or other error code
+ */
+cdyar_returncode cdyar_view_get(const cdyar_view *view, const size_t index,
+                                void *outptr);
+
+/**
+ * @brief Finds the first element of a view equivalent to a key
+ *
+ * @param view Pointer to the view
+ * @param keyptr Pointer to the value to look for
+ * @param cmp Comparator called as cmp(element, keyptr)
+ * @param outptr Pointer to where the index of the element will be stored
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_NOT_FOUND if no element
+ *         compares equal, or other error code
+ */
+cdyar_returncode cdyar_view_find(const cdyar_view *view, const void *keyptr,
+                                 const cdyar_comparator cmp, size_t *outptr);
+
+/**
+ * @brief Sorts the elements of a view in place
+ *
+ * Contiguous views are sorted with qsort, strided ones with an in-place
+ * heapsort. Only the viewed elements move; for field views this means
+ * only that field of every struct is reordered.
+ *
+ * @param view Pointer to the view
+ * @param cmp Comparator giving the order
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_view_sort(const cdyar_view *view,
+                                 const cdyar_comparator cmp);
+
+/**
+ * @brief Creates a cursor over the elements of a view
+ *
+ * @param view Pointer to the view
+ * @param prefetch Prefetch distance hint in elements, or
+ *                 CDYAR_CURSOR_NO_PREFETCH
+ * @param outptr Pointer to the cursor to initialize
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_view_cursor(const cdyar_view *view,
+                                   const size_t prefetch,
+                                   cdyar_cursor *outptr);
+
+/**
+ * @brief Creates a 2-D view of a row-major matrix stored in an array
+ *
+ * @param arr Pointer to the dynamic array holding rows * cols elements
+ * @param rows Number of rows
+ * @param cols Number of columns
+ * @param outptr Pointer to the view to initialize
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if the
+ *         matrix doesn't fit in the array's length, or other error code
+ */
+cdyar_returncode cdyar_nview2d(cdyar_darray *arr, const size_t rows,
+                               const size_t cols, cdyar_view2d *outptr);
+
+/**
+ * @brief Pointer to an element of a 2-D view, without bounds checking
+ *
+ * @param view Pointer to the view
+ * @param row Row of the element
+ * @param col Column of the element
+ * @return Pointer to the element inside the viewed buffer
+ */
+static inline void *cdyar_view2d_at(const cdyar_view2d *view, const size_t row,
+                                    const size_t col) {
+  return view->base + ((ptrdiff_t)row * view->rowstride) +
+         ((ptrdiff_t)col * view->colstride);
+}
+
+/**
+ * @brief Creates a view of one row of a 2-D view
+ *
+ * @param view Pointer to the 2-D view
+ * @param row Index of the row
+ * @param outptr Pointer to the view to initialize
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if row is out
+ *         of bounds, or other error code
+ */
+cdyar_returncode cdyar_view2d_row(const cdyar_view2d *view, const size_t row,
+                                  cdyar_view *outptr);
+
+/**
+ * @brief Creates a view of one column of a 2-D view
+ *
+ * @param view Pointer to the 2-D view
+ * @param col Index of the column
+ * @param outptr Pointer to the view to initialize
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if col is out
+ *         of bounds, or other error code
+ */
+cdyar_returncode cdyar_view2d_col(const cdyar_view2d *view, const size_t col,
+                                  cdyar_view *outptr);
+
+/**
+ * @brief Creates a 2-D view of a rectangular block of another 2-D view
+ *
+ * @param view Pointer to the 2-D view
+ * @param row First row of the block
+ * @param col First column of the block
+ * @param rows Number of rows of the block
+ * @param cols Number of columns of the block
+ * @param outptr Pointer to the view to initialize (may be view itself)
+ * @return CDYAR_SUCCESSFUL on success, CDYAR_ARR_OUT_OF_BOUNDS if the block
+ *         leaves view, or other error code
+ */
+cdyar_returncode cdyar_view2d_block(const cdyar_view2d *view, const size_t row,
+                                    const size_t col, const size_t rows,
+                                    const size_t cols, cdyar_view2d *outptr);
+
+/**
+ * @brief Creates the transpose of a 2-D view, without moving elements
+ *
+ * @param view Pointer to the 2-D view
+ * @param outptr Pointer to the view to initialize (may be view itself)
+ * @return CDYAR_SUCCESSFUL on success, error code otherwise
+ */
+cdyar_returncode cdyar_view2d_transpose(const cdyar_view2d *view,
+                                        cdyar_view2d *outptr);
+
+#endif
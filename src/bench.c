@@ -0,0 +1,275 @@
+#include "../headers/cdyar.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// benchmark driver for cdyar, built with release flags by 'make bench'
+// every measurement is printed as one CSV row on stdout:
+//   benchmark,variant,typesize,count,seconds,ns_per_op
+// usage: cdyar_bench [count]  (count of elements, default 1000000)
+
+// largest element size exercised, in bytes
+#define BENCH_MAX_TYPESIZE 256
+
+// removals shift the whole tail, so they run on fewer elements
+#define BENCH_RM_DIVISOR 50
+
+// written by every benchmark so the compiler can't drop the work
+static volatile unsigned char bench_sink;
+
+static double bench_now(void) {
+  struct timespec ts;
+  timespec_get(&ts, TIME_UTC);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void bench_report(const char *benchmark, const char *variant,
+                         size_t typesize, size_t count, double seconds) {
+  printf("%s,%s,%zu,%zu,%.6f,%.2f\n", benchmark, variant, typesize, count,
+         seconds, count ? seconds * 1e9 / (double)count : 0.0);
+}
+
+// xorshift64, good enough for picking indices
+static uint64_t bench_random(uint64_t *state) {
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+  return *state;
+}
+
+static cdyar_returncode bench_narr(cdyar_darray *arr, size_t typesize,
+                                   size_t capacity, cdyar_resizepolicy policy) {
+  return cdyar_narr(typesize, capacity, policy, cdyar_generic_typehandler,
+                    CDYAR_ARR_AUTO_RESIZE, arr);
+}
+
+/*
+    append count elements of every size, to a cdyar array and to a raw
+   buffer grown by doubling with realloc
+*/
+static int bench_append(size_t count) {
+  static const size_t typesizes[] = {4, 16, 64, BENCH_MAX_TYPESIZE};
+  unsigned char value[BENCH_MAX_TYPESIZE];
+  memset(value, 0xab, sizeof(value));
+
+  for (size_t t = 0; t < sizeof(typesizes) / sizeof(typesizes[0]); t++) {
+    size_t typesize = typesizes[t];
+
+    cdyar_darray arr;
+    if (bench_narr(&arr, typesize, 1, CDYAR_DEFAULT_RESIZE_POLICY) !=
+        CDYAR_SUCCESSFUL) {
+      return 1;
+    }
+    double start = bench_now();
+    for (size_t i = 0; i < count; i++) {
+      cdyar_set(&arr, i, value);
+    }
+    bench_report("append", "cdyar", typesize, count, bench_now() - start);
+    bench_sink = ((unsigned char *)arr.elements)[0];
+    cdyar_darr(&arr);
+
+    unsigned char *raw = NULL;
+    size_t capacity = 0;
+    start = bench_now();
+    for (size_t i = 0; i < count; i++) {
+      if (i == capacity) {
+        capacity = capacity ? capacity * 2 : 1;
+        unsigned char *temp = realloc(raw, capacity * typesize);
+        if (!temp) {
+          free(raw);
+          return 1;
+        }
+        raw = temp;
+      }
+      memcpy(raw + (i * typesize), value, typesize);
+    }
+    bench_report("append", "raw", typesize, count, bench_now() - start);
+    bench_sink = raw[0];
+    free(raw);
+  }
+  return 0;
+}
+
+/*
+    read every element in order, then count elements at random positions,
+   through cdyar_get, through a cursor and straight from a raw buffer
+*/
+static int bench_get(size_t count) {
+  cdyar_darray arr;
+  if (bench_narr(&arr, sizeof(uint64_t), count, CDYAR_DEFAULT_RESIZE_POLICY) !=
+      CDYAR_SUCCESSFUL) {
+    return 1;
+  }
+  uint64_t *raw = malloc(count * sizeof(uint64_t));
+  size_t *positions = malloc(count * sizeof(size_t));
+  if (!raw || !positions) {
+    free(raw);
+    free(positions);
+    cdyar_darr(&arr);
+    return 1;
+  }
+
+  uint64_t state = 0x9e3779b97f4a7c15ULL;
+  for (size_t i = 0; i < count; i++) {
+    uint64_t value = i;
+    cdyar_set(&arr, i, &value);
+    raw[i] = value;
+    positions[i] = (size_t)(bench_random(&state) % count);
+  }
+
+  uint64_t sum = 0, value = 0;
+  double start = bench_now();
+  for (size_t i = 0; i < count; i++) {
+    cdyar_get(&arr, i, &value);
+    sum += value;
+  }
+  bench_report("get_sequential", "cdyar", sizeof(uint64_t), count,
+               bench_now() - start);
+
+  cdyar_cursor cursor;
+  start = bench_now();
+  cdyar_ncursor(&arr, 0, 1, CDYAR_CURSOR_NO_PREFETCH, &cursor);
+  for (uint64_t *x; (x = cdyar_cursor_next(&cursor));) {
+    sum += *x;
+  }
+  bench_report("get_sequential", "cdyar_cursor", sizeof(uint64_t), count,
+               bench_now() - start);
+
+  start = bench_now();
+  for (size_t i = 0; i < count; i++) {
+    sum += raw[i];
+  }
+  bench_report("get_sequential", "raw", sizeof(uint64_t), count,
+               bench_now() - start);
+
+  start = bench_now();
+  for (size_t i = 0; i < count; i++) {
+    cdyar_get(&arr, positions[i], &value);
+    sum += value;
+  }
+  bench_report("get_random", "cdyar", sizeof(uint64_t), count,
+               bench_now() - start);
+
+  start = bench_now();
+  for (size_t i = 0; i < count; i++) {
+    sum += raw[positions[i]];
+  }
+  bench_report("get_random", "raw", sizeof(uint64_t), count,
+               bench_now() - start);
+
+  bench_sink = (unsigned char)sum;
+  free(positions);
+  free(raw);
+  cdyar_darr(&arr);
+  return 0;
+}
+
+/*
+    empty an array by repeatedly removing its first, middle or last element,
+   with cdyar_rm and with memmove on a raw buffer
+*/
+static int bench_rm(size_t count) {
+  static const char *positions[] = {"front", "middle", "back"};
+  char name[32];
+
+  for (size_t p = 0; p < sizeof(positions) / sizeof(positions[0]); p++) {
+    snprintf(name, sizeof(name), "rm_%s", positions[p]);
+
+    cdyar_darray arr;
+    if (bench_narr(&arr, sizeof(uint64_t), count,
+                   CDYAR_DEFAULT_RESIZE_POLICY) != CDYAR_SUCCESSFUL) {
+      return 1;
+    }
+    uint64_t *raw = malloc(count * sizeof(uint64_t));
+    if (!raw) {
+      cdyar_darr(&arr);
+      return 1;
+    }
+    for (size_t i = 0; i < count; i++) {
+      uint64_t value = i;
+      cdyar_set(&arr, i, &value);
+      raw[i] = value;
+    }
+
+    double start = bench_now();
+    while (arr.length > 0) {
+      size_t index = p == 0 ? 0 : p == 1 ? arr.length / 2 : arr.length - 1;
+      cdyar_rm(&arr, index);
+    }
+    bench_report(name, "cdyar", sizeof(uint64_t), count, bench_now() - start);
+
+    size_t length = count;
+    start = bench_now();
+    while (length > 0) {
+      size_t index = p == 0 ? 0 : p == 1 ? length / 2 : length - 1;
+      memmove(raw + index, raw + index + 1,
+              (length - index - 1) * sizeof(uint64_t));
+      length--;
+    }
+    bench_report(name, "raw", sizeof(uint64_t), count, bench_now() - start);
+
+    bench_sink = (unsigned char)raw[0];
+    free(raw);
+    cdyar_darr(&arr);
+  }
+  return 0;
+}
+
+/*
+    append count elements starting from small initial capacities, with each
+   built-in resize policy
+*/
+static int bench_growth(size_t count) {
+  static const size_t capacities[] = {1, 16, 1024};
+  static const struct {
+    const char *name;
+    cdyar_resizepolicy policy;
+  } policies[] = {
+      {"default", CDYAR_DEFAULT_RESIZE_POLICY},
+      {"incremental", cdyar_incremental_resize_policy},
+      {"adaptive", cdyar_adaptive_resize_policy},
+  };
+  char name[32];
+
+  for (size_t c = 0; c < sizeof(capacities) / sizeof(capacities[0]); c++) {
+    snprintf(name, sizeof(name), "growth_from_%zu", capacities[c]);
+    for (size_t p = 0; p < sizeof(policies) / sizeof(policies[0]); p++) {
+      cdyar_darray arr;
+      if (bench_narr(&arr, sizeof(uint64_t), capacities[c],
+                     policies[p].policy) != CDYAR_SUCCESSFUL) {
+        return 1;
+      }
+      double start = bench_now();
+      for (size_t i = 0; i < count; i++) {
+        uint64_t value = i;
+        cdyar_set(&arr, i, &value);
+      }
+      bench_report(name, policies[p].name, sizeof(uint64_t), count,
+                   bench_now() - start);
+      cdyar_darr(&arr);
+    }
+  }
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  size_t count = 1000000;
+  if (argc > 1) {
+    count = strtoull(argv[1], NULL, 10);
+    if (count == 0) {
+      fprintf(stderr, "usage: %s [count]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  printf("benchmark,variant,typesize,count,seconds,ns_per_op\n");
+  size_t rmcount = count / BENCH_RM_DIVISOR ? count / BENCH_RM_DIVISOR : 1;
+  if (bench_append(count) || bench_get(count) || bench_rm(rmcount) ||
+      bench_growth(count)) {
+    fprintf(stderr, "benchmark setup failed: out of memory\n");
+    return 1;
+  }
+  return 0;
+}
@@ -1,4 +1,10 @@
 #include "../headers/cdyar_arithmetic.h"
+#include "../headers/cdyar_darray.h"
+#include "../headers/cdyar_hashindex.h"
+#include "../headers/cdyar_stats.h"
+#include "../headers/cdyar_trace.h"
+#include <stdint.h>
+#include <string.h>
 
 void cdyar_check_sizet_overflow(const size_t count, cdyar_returncode* code, ...) {
     //check code is not null
@@ -125,3 +131,479 @@ void cdyar_uintpow(const unsigned int base, const unsigned int exponent, unsigne
     *outptr = result;
     *code = CDYAR_SUCCESSFUL;
 }
+
+/*
+    numeric kernels
+    one set of static kernels is generated per element type by
+   CDYAR_DEFINE_NUMERIC_KERNELS. args of the macro:
+     type : the element type
+     suffix: suffix of the generated function names
+     acc  : type sums and dot products are returned in
+     wide : type the arithmetic is done in. unsigned types for the integers,
+            so that the arithmetic wraps around instead of overflowing
+     narrow: type element-wise arithmetic is done in, unsigned for integers
+   reductions keep CDYAR_NUMERIC_LANES independent accumulators in an
+   array and update all of them in an inner loop over the lanes. the
+   accumulators then don't depend on each other, and the compiler turns
+   the inner loop into a few SIMD instructions (this is the form gcc
+   vectorizes min and max of floats in without -ffast-math). kernels take
+   restrict pointers so no aliasing checks are needed, cdyar_addself_
+   covers adding an array to itself
+*/
+#define CDYAR_NUMERIC_LANES 8
+
+#define CDYAR_DEFINE_NUMERIC_KERNELS(type, suffix, acc, wide, narrow)         \
+  static acc cdyar_sum_##suffix(const type *restrict x, size_t n) {           \
+    wide lanes[CDYAR_NUMERIC_LANES] = {0};                                    \
+    size_t i = 0;                                                             \
+    for (; i + CDYAR_NUMERIC_LANES <= n; i += CDYAR_NUMERIC_LANES) {          \
+      for (size_t k = 0; k < CDYAR_NUMERIC_LANES; k++) {                      \
+        lanes[k] += (wide)(acc)x[i + k];                                      \
+      }                                                                       \
+    }                                                                         \
+    for (; i < n; i++) {                                                      \
+      lanes[0] += (wide)(acc)x[i];                                            \
+    }                                                                         \
+    wide total = 0;                                                           \
+    for (size_t k = 0; k < CDYAR_NUMERIC_LANES; k++) {                        \
+      total += lanes[k];                                                      \
+    }                                                                         \
+    return (acc)total;                                                        \
+  }                                                                           \
+                                                                              \
+  static acc cdyar_dot_##suffix(const type *restrict x,                       \
+                                const type *restrict y, size_t n) {           \
+    wide lanes[CDYAR_NUMERIC_LANES] = {0};                                    \
+    size_t i = 0;                                                             \
+    for (; i + CDYAR_NUMERIC_LANES <= n; i += CDYAR_NUMERIC_LANES) {          \
+      for (size_t k = 0; k < CDYAR_NUMERIC_LANES; k++) {                      \
+        lanes[k] += (wide)(acc)x[i + k] * (wide)(acc)y[i + k];                \
+      }                                                                       \
+    }                                                                         \
+    for (; i < n; i++) {                                                      \
+      lanes[0] += (wide)(acc)x[i] * (wide)(acc)y[i];                          \
+    }                                                                         \
+    wide total = 0;                                                           \
+    for (size_t k = 0; k < CDYAR_NUMERIC_LANES; k++) {                        \
+      total += lanes[k];                                                      \
+    }                                                                         \
+    return (acc)total;                                                        \
+  }                                                                           \
+                                                                              \
+  static void cdyar_minmax_##suffix(const type *restrict x, size_t n,        \
+                                    type *min, type *max) {                   \
+    type lo[CDYAR_NUMERIC_LANES], hi[CDYAR_NUMERIC_LANES];                    \
+    for (size_t k = 0; k < CDYAR_NUMERIC_LANES; k++) {                        \
+      lo[k] = x[0];                                                           \
+      hi[k] = x[0];                                                           \
+    }                                                                         \
+    size_t i = 0;                                                             \
+    for (; i + CDYAR_NUMERIC_LANES <= n; i += CDYAR_NUMERIC_LANES) {          \
+      for (size_t k = 0; k < CDYAR_NUMERIC_LANES; k++) {                      \
+        lo[k] = x[i + k] < lo[k] ? x[i + k] : lo[k];                          \
+        hi[k] = x[i + k] > hi[k] ? x[i + k] : hi[k];                          \
+      }                                                                       \
+    }                                                                         \
+    for (; i < n; i++) {                                                      \
+      lo[0] = x[i] < lo[0] ? x[i] : lo[0];                                    \
+      hi[0] = x[i] > hi[0] ? x[i] : hi[0];                                    \
+    }                                                                         \
+    for (size_t k = 1; k < CDYAR_NUMERIC_LANES; k++) {                        \
+      lo[0] = lo[k] < lo[0] ? lo[k] : lo[0];                                  \
+      hi[0] = hi[k] > hi[0] ? hi[k] : hi[0];                                  \
+    }                                                                         \
+    *min = lo[0];                                                             \
+    *max = hi[0];                                                             \
+  }                                                                           \
+                                                                              \
+  static void cdyar_add_##suffix(type *restrict x, const type *restrict y,    \
+                                 size_t n) {                                  \
+    for (size_t i = 0; i < n; i++) {                                          \
+      x[i] = (type)((narrow)x[i] + (narrow)y[i]);                             \
+    }                                                                         \
+  }                                                                           \
+                                                                              \
+  static void cdyar_addself_##suffix(type *restrict x, size_t n) {            \
+    for (size_t i = 0; i < n; i++) {                                          \
+      x[i] = (type)((narrow)x[i] + (narrow)x[i]);                             \
+    }                                                                         \
+  }                                                                           \
+                                                                              \
+  static void cdyar_scale_##suffix(type *restrict x, size_t n, type factor) { \
+    for (size_t i = 0; i < n; i++) {                                          \
+      x[i] = (type)((narrow)x[i] * (narrow)factor);                           \
+    }                                                                         \
+  }                                                                           \
+                                                                              \
+  static void cdyar_clamp_##suffix(type *restrict x, size_t n, type low,     \
+                                   type high) {                               \
+    for (size_t i = 0; i < n; i++) {                                          \
+      type value = x[i] < low ? low : x[i];                                   \
+      x[i] = value > high ? high : value;                                     \
+    }                                                                         \
+  }
+
+CDYAR_DEFINE_NUMERIC_KERNELS(int32_t, i32, int64_t, uint64_t, uint32_t)
+CDYAR_DEFINE_NUMERIC_KERNELS(int64_t, i64, int64_t, uint64_t, uint64_t)
+CDYAR_DEFINE_NUMERIC_KERNELS(float, f32, double, double, float)
+CDYAR_DEFINE_NUMERIC_KERNELS(double, f64, double, double, double)
+
+/*
+    internal function
+    calls the kernel of the element type given by a numeric type tag.
+   expands to nothing for other flags
+*/
+#define CDYAR_NUMERIC_DISPATCH(tag, kernel, ...)                              \
+  switch (tag) {                                                              \
+  case CDYAR_ARR_INT32:                                                       \
+    kernel(int32_t, i32, int64_t, __VA_ARGS__);                               \
+    break;                                                                    \
+  case CDYAR_ARR_INT64:                                                       \
+    kernel(int64_t, i64, int64_t, __VA_ARGS__);                               \
+    break;                                                                    \
+  case CDYAR_ARR_FLOAT:                                                       \
+    kernel(float, f32, double, __VA_ARGS__);                                  \
+    break;                                                                    \
+  case CDYAR_ARR_DOUBLE:                                                      \
+    kernel(double, f64, double, __VA_ARGS__);                                 \
+    break;                                                                    \
+  default:                                                                    \
+    break;                                                                    \
+  }
+
+/*
+    internal function
+    check that arr is a numeric array and prepare its buffer for a kernel:
+   the elements have to be in a single buffer, and one that is about to be
+   written (write is cdyar_true) must not be shared with a clone. stores
+   the numeric type tag in *tag
+*/
+static cdyar_returncode cdyar_numeric_prepare(const cdyar_darray *arr,
+                                              cdyar_bool write,
+                                              cdyar_flag *tag) {
+  // check that an elements array actually exists within the dynamic array
+  if (CDYAR_STRUCTURE_FAILS(!arr->elements)) {
+    *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // only arrays created with a numeric type tag have kernels
+  *tag = arr->flags & CDYAR_ARR_NUMERIC_MASK;
+  if (*tag == 0) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // finishing an incremental resize moves elements between buffers without
+  // changing the array's logical contents, so it is done even through a
+  // const pointer, like cdyar_get does
+  cdyar_finishresize((cdyar_darray *)arr);
+  if (write && cdyar_unshare((cdyar_darray *)arr) != CDYAR_SUCCESSFUL) {
+    return *arr->code;
+  }
+
+  *arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+/*
+    internal function
+    check the second array of a two-array kernel, reporting problems in the
+   first one's code
+*/
+static cdyar_returncode cdyar_numeric_checkpair(const cdyar_darray *arr,
+                                                const cdyar_darray *other) {
+  // check other is not null
+  if (CDYAR_BOUNDARY_FAILS(!other)) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(other->code);
+
+  // the arrays have to hold as many elements of the same type
+  if ((other->flags & CDYAR_ARR_NUMERIC_MASK) !=
+          (arr->flags & CDYAR_ARR_NUMERIC_MASK) ||
+      other->length != arr->length) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  cdyar_flag tag;
+  if (cdyar_numeric_prepare(other, cdyar_false, &tag) != CDYAR_SUCCESSFUL) {
+    *arr->code = *other->code;
+    return *arr->code;
+  }
+  return CDYAR_SUCCESSFUL;
+}
+
+/*
+    internal function
+    an element-wise kernel overwrote every element of arr in place: count
+   the writes in the stats and the trace, and rebuild an attached hash index
+   since any key may have changed
+*/
+static cdyar_returncode cdyar_numeric_written(cdyar_darray *arr) {
+  CDYAR_STAT_ADD(arr, sets, arr->length);
+  for (size_t i = 0; arr->trace && i < arr->length; i++) {
+    cdyar_trace_record(arr->trace, CDYAR_TRACE_SET, i, 0);
+  }
+
+  if (arr->index && cdyar_rebuildindex(arr) != CDYAR_SUCCESSFUL) {
+    return *arr->code;
+  }
+
+  *arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+#define CDYAR_SUM_KERNEL(type, suffix, acc, arr, outptr)                      \
+  *(acc *)(outptr) = cdyar_sum_##suffix((arr)->elements, (arr)->length)
+
+cdyar_returncode cdyar_sum(const cdyar_darray *arr, void *outptr) {
+  // check arr is not null
+  if (CDYAR_BOUNDARY_FAILS(!arr)) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // check outptr is not null
+  if (CDYAR_BOUNDARY_FAILS(!outptr)) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  cdyar_flag tag;
+  if (cdyar_numeric_prepare(arr, cdyar_false, &tag) != CDYAR_SUCCESSFUL) {
+    return *arr->code;
+  }
+
+  CDYAR_NUMERIC_DISPATCH(tag, CDYAR_SUM_KERNEL, arr, outptr)
+  return CDYAR_SUCCESSFUL;
+}
+
+#define CDYAR_MINMAX_KERNEL(type, suffix, acc, arr, minptr, maxptr)           \
+  do {                                                                        \
+    type min, max;                                                            \
+    cdyar_minmax_##suffix((arr)->elements, (arr)->length, &min, &max);        \
+    if (minptr) {                                                             \
+      memcpy((minptr), &min, sizeof(type));                                   \
+    }                                                                         \
+    if (maxptr) {                                                             \
+      memcpy((maxptr), &max, sizeof(type));                                   \
+    }                                                                         \
+  } while (0)
+
+/*
+    internal function
+    shared body of cdyar_min and cdyar_max, one pass finds both
+*/
+static cdyar_returncode cdyar_minmax(const cdyar_darray *arr, void *minptr,
+                                     void *maxptr) {
+  // check arr is not null
+  if (CDYAR_BOUNDARY_FAILS(!arr)) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // check the requested outptr is not null
+  if (CDYAR_BOUNDARY_FAILS(!minptr && !maxptr)) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  cdyar_flag tag;
+  if (cdyar_numeric_prepare(arr, cdyar_false, &tag) != CDYAR_SUCCESSFUL) {
+    return *arr->code;
+  }
+
+  // an empty array has neither
+  if (arr->length == 0) {
+    *arr->code = CDYAR_ARR_OUT_OF_BOUNDS;
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+
+  CDYAR_NUMERIC_DISPATCH(tag, CDYAR_MINMAX_KERNEL, arr, minptr, maxptr)
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_min(const cdyar_darray *arr, void *outptr) {
+  return cdyar_minmax(arr, outptr, NULL);
+}
+
+cdyar_returncode cdyar_max(const cdyar_darray *arr, void *outptr) {
+  return cdyar_minmax(arr, NULL, outptr);
+}
+
+#define CDYAR_MEAN_KERNEL(type, suffix, acc, arr, outptr)                     \
+  *(outptr) = (double)cdyar_sum_##suffix((arr)->elements, (arr)->length) /    \
+              (double)(arr)->length
+
+cdyar_returncode cdyar_mean(const cdyar_darray *arr, double *outptr) {
+  // check arr is not null
+  if (CDYAR_BOUNDARY_FAILS(!arr)) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // check outptr is not null
+  if (CDYAR_BOUNDARY_FAILS(!outptr)) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  cdyar_flag tag;
+  if (cdyar_numeric_prepare(arr, cdyar_false, &tag) != CDYAR_SUCCESSFUL) {
+    return *arr->code;
+  }
+
+  // the mean of nothing is not a number
+  if (arr->length == 0) {
+    *arr->code = CDYAR_ARR_OUT_OF_BOUNDS;
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+
+  CDYAR_NUMERIC_DISPATCH(tag, CDYAR_MEAN_KERNEL, arr, outptr)
+  return CDYAR_SUCCESSFUL;
+}
+
+#define CDYAR_DOT_KERNEL(type, suffix, acc, left, right, outptr)              \
+  *(acc *)(outptr) = cdyar_dot_##suffix((left)->elements, (right)->elements, \
+                                        (left)->length)
+
+cdyar_returncode cdyar_dot(const cdyar_darray *left, const cdyar_darray *right,
+                           void *outptr) {
+  // check left is not null
+  if (CDYAR_BOUNDARY_FAILS(!left)) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(left->code);
+
+  // check outptr is not null
+  if (CDYAR_BOUNDARY_FAILS(!outptr)) {
+    *left->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  cdyar_flag tag;
+  if (cdyar_numeric_prepare(left, cdyar_false, &tag) != CDYAR_SUCCESSFUL ||
+      cdyar_numeric_checkpair(left, right) != CDYAR_SUCCESSFUL) {
+    return *left->code;
+  }
+
+  CDYAR_NUMERIC_DISPATCH(tag, CDYAR_DOT_KERNEL, left, right, outptr)
+  *left->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+#define CDYAR_ADD_KERNEL(type, suffix, acc, dst, src)                         \
+  do {                                                                        \
+    if ((dst)->elements == (src)->elements) {                                 \
+      cdyar_addself_##suffix((dst)->elements, (dst)->length);                 \
+    } else {                                                                  \
+      cdyar_add_##suffix((dst)->elements, (src)->elements, (dst)->length);    \
+    }                                                                         \
+  } while (0)
+
+cdyar_returncode cdyar_add(cdyar_darray *dst, const cdyar_darray *src) {
+  // check dst is not null
+  if (CDYAR_BOUNDARY_FAILS(!dst)) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(dst->code);
+
+  cdyar_flag tag;
+  if (cdyar_numeric_prepare(dst, cdyar_true, &tag) != CDYAR_SUCCESSFUL ||
+      cdyar_numeric_checkpair(dst, src) != CDYAR_SUCCESSFUL) {
+    return *dst->code;
+  }
+
+  CDYAR_NUMERIC_DISPATCH(tag, CDYAR_ADD_KERNEL, dst, src)
+  return cdyar_numeric_written(dst);
+}
+
+#define CDYAR_SCALE_KERNEL(type, suffix, acc, arr, factorptr)                 \
+  do {                                                                        \
+    type factor;                                                              \
+    memcpy(&factor, (factorptr), sizeof(type));                               \
+    cdyar_scale_##suffix((arr)->elements, (arr)->length, factor);             \
+  } while (0)
+
+cdyar_returncode cdyar_scale(cdyar_darray *arr, const void *factorptr) {
+  // check arr is not null
+  if (CDYAR_BOUNDARY_FAILS(!arr)) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // check factorptr is not null
+  if (CDYAR_BOUNDARY_FAILS(!factorptr)) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  cdyar_flag tag;
+  if (cdyar_numeric_prepare(arr, cdyar_true, &tag) != CDYAR_SUCCESSFUL) {
+    return *arr->code;
+  }
+
+  CDYAR_NUMERIC_DISPATCH(tag, CDYAR_SCALE_KERNEL, arr, factorptr)
+  return cdyar_numeric_written(arr);
+}
+
+#define CDYAR_CLAMP_KERNEL(type, suffix, acc, arr, lowptr, highptr, ok)       \
+  do {                                                                        \
+    type low, high;                                                           \
+    memcpy(&low, (lowptr), sizeof(type));                                     \
+    memcpy(&high, (highptr), sizeof(type));                                   \
+    *(ok) = low <= high ? cdyar_true : cdyar_false;                           \
+    if (*(ok)) {                                                              \
+      cdyar_clamp_##suffix((arr)->elements, (arr)->length, low, high);        \
+    }                                                                         \
+  } while (0)
+
+cdyar_returncode cdyar_clamp(cdyar_darray *arr, const void *lowptr,
+                             const void *highptr) {
+  // check arr is not null
+  if (CDYAR_BOUNDARY_FAILS(!arr)) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // check the bounds are not null
+  if (CDYAR_BOUNDARY_FAILS(!lowptr || !highptr)) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  cdyar_flag tag;
+  if (cdyar_numeric_prepare(arr, cdyar_true, &tag) != CDYAR_SUCCESSFUL) {
+    return *arr->code;
+  }
+
+  // the bounds must describe a range (NaN bounds don't)
+  cdyar_bool ordered = cdyar_false;
+  CDYAR_NUMERIC_DISPATCH(tag, CDYAR_CLAMP_KERNEL, arr, lowptr, highptr,
+                         &ordered)
+  if (!ordered) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  return cdyar_numeric_written(arr);
+}
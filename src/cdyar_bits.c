@@ -0,0 +1,422 @@
+#include "../headers/cdyar_bits.h"
+#include "../headers/cdyar_arithmetic.h"
+#include <stdint.h>
+#include <string.h>
+
+/*
+    internal enum
+    bulk operations supported by cdyar_bits_bulkop
+*/
+enum cdyar_bits_ops {
+  CDYAR_BITS_OP_AND,
+  CDYAR_BITS_OP_OR,
+  CDYAR_BITS_OP_XOR,
+};
+
+/*
+    internal function
+    number of set bits in a word, uses the compiler builtin (a single
+   instruction on most targets) when available
+*/
+static size_t cdyar_bits_wordpopcount(uint64_t word) {
+#if defined(__GNUC__)
+  return (size_t)__builtin_popcountll(word);
+#else
+  word = word - ((word >> 1) & 0x5555555555555555ULL);
+  word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+  word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return (size_t)((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/*
+    internal function
+    index of the lowest set bit in a word, word must not be zero
+*/
+static size_t cdyar_bits_wordctz(uint64_t word) {
+#if defined(__GNUC__)
+  return (size_t)__builtin_ctzll(word);
+#else
+  size_t count = 0;
+  while (!(word & 1)) {
+    word >>= 1;
+    count++;
+  }
+  return count;
+#endif
+}
+
+/*
+    internal function
+    number of words needed to hold a given number of bits
+*/
+static size_t cdyar_bits_wordcount(size_t bits) {
+  return bits / CDYAR_BITS_PER_WORD + (bits % CDYAR_BITS_PER_WORD != 0);
+}
+
+/*
+    internal function
+    doubles the capacity of a bit array, mirroring the default resize policy
+   of cdyar_darray (the new portion is zeroed)
+
+    args: 1) cdyar_bitarray* arr   : a pointer to the bit array
+          2) cdyar_returncode* code: a pointer to a returncode variable to
+   store status returns: void
+*/
+static void cdyar_bits_resize(cdyar_bitarray *arr, cdyar_returncode *code) {
+  // check code is not null
+  CDYAR_CHECK_CODE(code);
+
+  size_t words = arr->capacity / CDYAR_BITS_PER_WORD;
+
+  // check overflow, the capacity in bits has to stay representable too
+  size_t doubled, bytes;
+  if (cdyar_mul_overflows(arr->capacity, 2, &doubled) ||
+      cdyar_mul_overflows(words, 2 * sizeof(uint64_t), &bytes)) {
+    *code = CDYAR_SIZE_T_OVERFLOW;
+    return;
+  }
+
+  // resize the words array
+  uint64_t *words_temp = realloc(arr->words, words * 2 * sizeof(uint64_t));
+  if (!words_temp) {
+    *code = CDYAR_MEMORY_ERROR;
+    return;
+  }
+
+  // zero out the new portion of the array
+  arr->words = words_temp;
+  memset(arr->words + words, 0, words * sizeof(uint64_t));
+
+  // make sure to double the capacity
+  arr->capacity *= 2;
+  *code = CDYAR_SUCCESSFUL;
+}
+
+/*
+    internal function
+    shared implementation of cdyar_bits_and, cdyar_bits_or and cdyar_bits_xor
+*/
+static cdyar_returncode cdyar_bits_bulkop(cdyar_bitarray *dst,
+                                          const cdyar_bitarray *src,
+                                          enum cdyar_bits_ops op) {
+  // check dst is not null
+  if (!dst) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(dst->code);
+
+  // check src is not null
+  if (!src) {
+    *dst->code = CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check that both words arrays exist
+  if (!dst->words || !src->words) {
+    *dst->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // both arrays must hold the same number of bits
+  if (dst->length != src->length) {
+    *dst->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // the bits past length are zero in both arrays, so they stay zero for
+  // every supported operation and whole words can be combined
+  size_t words = cdyar_bits_wordcount(dst->length);
+  uint64_t *left = dst->words;
+  const uint64_t *right = src->words;
+  switch (op) {
+  case CDYAR_BITS_OP_AND:
+    for (size_t i = 0; i < words; i++) {
+      left[i] &= right[i];
+    }
+    break;
+  case CDYAR_BITS_OP_OR:
+    for (size_t i = 0; i < words; i++) {
+      left[i] |= right[i];
+    }
+    break;
+  case CDYAR_BITS_OP_XOR:
+    for (size_t i = 0; i < words; i++) {
+      left[i] ^= right[i];
+    }
+    break;
+  }
+
+  *dst->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_nbits(const size_t capacity, cdyar_bitarray *outptr) {
+  // make sure outptr is not null
+  if (!outptr) {
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // make sure capacity passed is positive
+  if (capacity == 0) {
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // create a cdyar_returncode for the bit array
+  cdyar_returncode *code = malloc(sizeof(cdyar_returncode));
+  if (!code) {
+    return CDYAR_MEMORY_ERROR;
+  }
+  *code = CDYAR_SUCCESSFUL;
+
+  // make sure the capacity in bits is still representable once rounded up
+  size_t words = cdyar_bits_wordcount(capacity);
+  if (words > SIZE_MAX / CDYAR_BITS_PER_WORD) {
+    free(code);
+    return CDYAR_SIZE_T_OVERFLOW;
+  }
+
+  // allocate zeroed memory for the words
+  outptr->words = calloc(words, sizeof(uint64_t));
+  if (!outptr->words) {
+    free(code);
+    return CDYAR_MEMORY_ERROR;
+  }
+
+  // set properties, indicate success
+  outptr->length = 0;
+  outptr->capacity = words * CDYAR_BITS_PER_WORD;
+  outptr->code = code;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_dbits(cdyar_bitarray *arr) {
+  // make sure arr is not null
+  if (!arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  CDYAR_CHECK_CODE(arr->code);
+
+  // if the words array exists, free it
+  if (arr->words) {
+    free(arr->words);
+    arr->words = NULL;
+  } else {
+    *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // free code
+  cdyar_returncode tempcode = *arr->code;
+  free(arr->code);
+  arr->code = NULL;
+
+  return tempcode;
+}
+
+cdyar_returncode cdyar_bits_set(cdyar_bitarray *arr, const size_t index,
+                                const cdyar_bool value) {
+  // check that arr is not null
+  if (!arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check that code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // check that the words array exists
+  if (!arr->words) {
+    *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // either replace an existing bit or append right after the last one
+  if (index > arr->length) {
+    *arr->code = CDYAR_ARR_OUT_OF_BOUNDS;
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+
+  if (index == arr->length) {
+    if (arr->length == arr->capacity) {
+      // no room left for another bit, resize
+      cdyar_bits_resize(arr, arr->code);
+      if (*arr->code != CDYAR_SUCCESSFUL) {
+        return *arr->code;
+      }
+    }
+    arr->length += 1;
+  }
+
+  uint64_t mask = (uint64_t)1 << (index % CDYAR_BITS_PER_WORD);
+  if (value) {
+    arr->words[index / CDYAR_BITS_PER_WORD] |= mask;
+  } else {
+    arr->words[index / CDYAR_BITS_PER_WORD] &= ~mask;
+  }
+
+  *arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_bits_get(const cdyar_bitarray *arr, const size_t index,
+                                cdyar_bool *outptr) {
+  // check arr is not null
+  if (!arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // check outptr is not null
+  if (!outptr) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // check that the words array exists
+  if (!arr->words) {
+    *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // bounds checking
+  if (index >= arr->length) {
+    *arr->code = CDYAR_ARR_OUT_OF_BOUNDS;
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+
+  uint64_t word = arr->words[index / CDYAR_BITS_PER_WORD];
+  *outptr = (word >> (index % CDYAR_BITS_PER_WORD)) & 1 ? cdyar_true
+                                                        : cdyar_false;
+
+  *arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_bits_push(cdyar_bitarray *arr, const cdyar_bool value) {
+  // check that arr is not null
+  if (!arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  return cdyar_bits_set(arr, arr->length, value);
+}
+
+cdyar_returncode cdyar_bits_clear(cdyar_bitarray *arr) {
+  // check that arr is not null
+  if (!arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check that code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // check that the words array exists
+  if (!arr->words) {
+    *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // only the words covering length can hold set bits
+  memset(arr->words, 0,
+         cdyar_bits_wordcount(arr->length) * sizeof(uint64_t));
+
+  *arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_bits_popcount(const cdyar_bitarray *arr,
+                                     size_t *outptr) {
+  // check arr is not null
+  if (!arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // check outptr is not null
+  if (!outptr) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // check that the words array exists
+  if (!arr->words) {
+    *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // bits past length are zero, whole words can be counted
+  size_t words = cdyar_bits_wordcount(arr->length);
+  size_t count = 0;
+  for (size_t i = 0; i < words; i++) {
+    count += cdyar_bits_wordpopcount(arr->words[i]);
+  }
+
+  *outptr = count;
+  *arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_bits_ffs(const cdyar_bitarray *arr, const size_t start,
+                                size_t *outptr) {
+  // check arr is not null
+  if (!arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // check outptr is not null
+  if (!outptr) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // check that the words array exists
+  if (!arr->words) {
+    *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // nothing to find past the end
+  *outptr = arr->length;
+  if (start >= arr->length) {
+    *arr->code = CDYAR_SUCCESSFUL;
+    return CDYAR_SUCCESSFUL;
+  }
+
+  // mask off the bits before start in the first word, then skip empty words
+  size_t words = cdyar_bits_wordcount(arr->length);
+  size_t i = start / CDYAR_BITS_PER_WORD;
+  uint64_t word = arr->words[i] & (~(uint64_t)0 << (start % CDYAR_BITS_PER_WORD));
+  while (!word && ++i < words) {
+    word = arr->words[i];
+  }
+
+  if (word) {
+    *outptr = i * CDYAR_BITS_PER_WORD + cdyar_bits_wordctz(word);
+  }
+
+  *arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_bits_and(cdyar_bitarray *dst,
+                                const cdyar_bitarray *src) {
+  return cdyar_bits_bulkop(dst, src, CDYAR_BITS_OP_AND);
+}
+
+cdyar_returncode cdyar_bits_or(cdyar_bitarray *dst, const cdyar_bitarray *src) {
+  return cdyar_bits_bulkop(dst, src, CDYAR_BITS_OP_OR);
+}
+
+cdyar_returncode cdyar_bits_xor(cdyar_bitarray *dst,
+                                const cdyar_bitarray *src) {
+  return cdyar_bits_bulkop(dst, src, CDYAR_BITS_OP_XOR);
+}
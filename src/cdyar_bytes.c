@@ -0,0 +1,263 @@
+#include "../headers/cdyar_bytes.h"
+#include "../headers/cdyar_hashindex.h"
+#include "../headers/cdyar_stats.h"
+#include "../headers/cdyar_trace.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/*
+    internal function
+    check that arr is a usable byte buffer, reporting problems in its code
+*/
+static cdyar_returncode cdyar_bytes_check(cdyar_darray *arr) {
+  // check that an elements array actually exists within the dynamic array
+  if (CDYAR_STRUCTURE_FAILS(!arr->elements)) {
+    *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // only arrays of single bytes are byte buffers
+  if (arr->typesize != 1) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  return CDYAR_SUCCESSFUL;
+}
+
+/*
+    internal function
+    make sure at least size bytes of spare capacity follow the last byte,
+   doubling the capacity unless that is not enough. reserving also unshares
+   the buffer and finishes an incremental resize, so the caller can write
+   into elements directly afterwards
+*/
+static cdyar_returncode cdyar_bytes_room(cdyar_darray *arr, size_t size) {
+  if (size > SIZE_MAX - arr->length) {
+    *arr->code = CDYAR_SIZE_T_OVERFLOW;
+    return CDYAR_SIZE_T_OVERFLOW;
+  }
+
+  size_t needed = arr->length + size;
+  size_t capacity = arr->capacity;
+  if (needed > capacity) {
+    capacity = (capacity <= SIZE_MAX / 2 && capacity * 2 > needed)
+                   ? capacity * 2
+                   : needed;
+  }
+  return cdyar_reserve(arr, capacity);
+}
+
+/*
+    internal function
+    make count bytes written after the last byte part of the buffer, and
+   add them to an attached hash index like any other appended element
+*/
+static cdyar_returncode cdyar_bytes_publish(cdyar_darray *arr, size_t count) {
+  size_t start = arr->length;
+  arr->length += count;
+  CDYAR_STAT_ADD(arr, sets, count);
+
+  for (size_t i = start; arr->index && i < arr->length; i++) {
+    cdyar_returncode code = cdyar_hashindex_insert(arr, i);
+    if (code != CDYAR_SUCCESSFUL) {
+      *arr->code = code;
+      return code;
+    }
+  }
+
+  for (size_t i = start; arr->trace && i < arr->length; i++) {
+    cdyar_trace_record(arr->trace, CDYAR_TRACE_SET, i, 0);
+  }
+
+  *arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_bytes_append(cdyar_darray *arr, const void *data,
+                                    const size_t size) {
+  // check arr is not null
+  if (CDYAR_BOUNDARY_FAILS(!arr)) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // check data is not null
+  if (CDYAR_BOUNDARY_FAILS(!data && size)) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  if (cdyar_bytes_check(arr) != CDYAR_SUCCESSFUL) {
+    return *arr->code;
+  }
+
+  // data may point into the buffer itself, which growing can move
+  cdyar_finishresize(arr);
+  const char *bytes = data;
+  uintptr_t address = (uintptr_t)data;
+  uintptr_t elements = (uintptr_t)arr->elements;
+  cdyar_bool inside = size && address >= elements &&
+                      address - elements < arr->capacity;
+  size_t offset = inside ? (size_t)(address - elements) : 0;
+
+  if (cdyar_bytes_room(arr, size) != CDYAR_SUCCESSFUL) {
+    return *arr->code;
+  }
+  if (inside) {
+    bytes = (const char *)arr->elements + offset;
+  }
+
+  memmove((char *)arr->elements + arr->length, bytes, size);
+  return cdyar_bytes_publish(arr, size);
+}
+
+cdyar_returncode cdyar_bytes_appendv(cdyar_darray *arr, const char *format,
+                                     va_list args) {
+  // check arr is not null
+  if (CDYAR_BOUNDARY_FAILS(!arr)) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // check format is not null
+  if (CDYAR_BOUNDARY_FAILS(!format)) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  if (cdyar_bytes_check(arr) != CDYAR_SUCCESSFUL) {
+    return *arr->code;
+  }
+
+  // the spare capacity is written to, it must not be shared with a clone
+  if (cdyar_bytes_room(arr, 0) != CDYAR_SUCCESSFUL) {
+    return *arr->code;
+  }
+
+  // first attempt straight into whatever spare capacity there is. the
+  // terminating zero vsnprintf writes lands in the spare capacity, which is
+  // zeroed anyway
+  va_list retry;
+  va_copy(retry, args);
+  size_t spare = arr->capacity - arr->length;
+  int written =
+      vsnprintf((char *)arr->elements + arr->length, spare, format, args);
+  if (written < 0) {
+    va_end(retry);
+    memset((char *)arr->elements + arr->length, 0, spare);
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // too long, grow to fit the text and its terminating zero and format again
+  if ((size_t)written >= spare) {
+    if (cdyar_bytes_room(arr, (size_t)written + 1) != CDYAR_SUCCESSFUL) {
+      va_end(retry);
+      memset((char *)arr->elements + arr->length, 0,
+             arr->capacity - arr->length);
+      return *arr->code;
+    }
+    vsnprintf((char *)arr->elements + arr->length, (size_t)written + 1,
+              format, retry);
+  }
+  va_end(retry);
+
+  return cdyar_bytes_publish(arr, (size_t)written);
+}
+
+cdyar_returncode cdyar_bytes_appendf(cdyar_darray *arr, const char *format,
+                                     ...) {
+  va_list args;
+  va_start(args, format);
+  cdyar_returncode code = cdyar_bytes_appendv(arr, format, args);
+  va_end(args);
+  return code;
+}
+
+cdyar_returncode cdyar_bytes_reserve(cdyar_darray *arr, const size_t size,
+                                     char **outptr) {
+  // check arr is not null
+  if (CDYAR_BOUNDARY_FAILS(!arr)) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // check outptr is not null
+  if (CDYAR_BOUNDARY_FAILS(!outptr)) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  if (cdyar_bytes_check(arr) != CDYAR_SUCCESSFUL) {
+    return *arr->code;
+  }
+
+  if (cdyar_bytes_room(arr, size) != CDYAR_SUCCESSFUL) {
+    return *arr->code;
+  }
+
+  *outptr = (char *)arr->elements + arr->length;
+  *arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_bytes_commit(cdyar_darray *arr, const size_t size) {
+  // check arr is not null
+  if (CDYAR_BOUNDARY_FAILS(!arr)) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  if (cdyar_bytes_check(arr) != CDYAR_SUCCESSFUL) {
+    return *arr->code;
+  }
+
+  // only bytes inside the capacity can have been written
+  if (CDYAR_BOUNDARY_FAILS(size > arr->capacity - arr->length)) {
+    *arr->code = CDYAR_ARR_OUT_OF_BOUNDS;
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+
+  return cdyar_bytes_publish(arr, size);
+}
+
+cdyar_returncode cdyar_bytes_cstr(cdyar_darray *arr, const char **outptr) {
+  // check arr is not null
+  if (CDYAR_BOUNDARY_FAILS(!arr)) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // check outptr is not null
+  if (CDYAR_BOUNDARY_FAILS(!outptr)) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  if (cdyar_bytes_check(arr) != CDYAR_SUCCESSFUL) {
+    return *arr->code;
+  }
+
+  // one byte of spare capacity holds the terminating zero
+  if (cdyar_bytes_room(arr, 1) != CDYAR_SUCCESSFUL) {
+    return *arr->code;
+  }
+
+  char *elements = arr->elements;
+  elements[arr->length] = '\0';
+  *outptr = elements;
+  *arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
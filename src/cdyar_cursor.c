@@ -0,0 +1,87 @@
+#include "../headers/cdyar_cursor.h"
+#include <stdint.h>
+
+cdyar_returncode cdyar_ncursor(cdyar_darray *arr, const size_t start,
+                               const ptrdiff_t step, const size_t prefetch,
+                               cdyar_cursor *outptr) {
+  // check arr is not null
+  if (!arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // check outptr is not null
+  if (!outptr) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // a step of zero would never leave the starting element
+  if (step == 0) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // check that an elements array actually exists within the dynamic array
+  if (!arr->elements) {
+    *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // the cursor walks a single buffer, an incremental resize must be done
+  if (cdyar_finishresize(arr) != CDYAR_SUCCESSFUL) {
+    return *arr->code;
+  }
+
+  // an empty array gives an empty cursor
+  if (arr->length == 0) {
+    outptr->current = arr->elements;
+    outptr->stride = 0;
+    outptr->remaining = 0;
+    outptr->prefetch = 0;
+    *arr->code = CDYAR_SUCCESSFUL;
+    return CDYAR_SUCCESSFUL;
+  }
+
+  // bounds checking
+  if (start >= arr->length) {
+    *arr->code = CDYAR_ARR_OUT_OF_BOUNDS;
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+
+  // make sure the stride in bytes fits in a ptrdiff_t
+  // (step is converted by hand because -PTRDIFF_MIN overflows)
+  size_t magnitude = step > 0 ? (size_t)step : (size_t)0 - (size_t)step;
+  if (magnitude > (size_t)PTRDIFF_MAX / arr->typesize) {
+    *arr->code = CDYAR_SIZE_T_OVERFLOW;
+    return CDYAR_SIZE_T_OVERFLOW;
+  }
+  size_t stride = magnitude * arr->typesize;
+
+  // same for the prefetch distance, which is measured in steps
+  if (prefetch != 0 && prefetch > (size_t)PTRDIFF_MAX / stride) {
+    *arr->code = CDYAR_SIZE_T_OVERFLOW;
+    return CDYAR_SIZE_T_OVERFLOW;
+  }
+
+  // count how many elements the cursor will visit before leaving the array
+  size_t remaining;
+  if (step > 0) {
+    remaining = 1 + (arr->length - 1 - start) / magnitude;
+  } else {
+    remaining = 1 + start / magnitude;
+  }
+
+  outptr->current = ((char *)arr->elements) + (arr->typesize * start);
+  outptr->stride = step > 0 ? (ptrdiff_t)stride : -(ptrdiff_t)stride;
+  outptr->remaining = remaining;
+  outptr->prefetch = (ptrdiff_t)(prefetch * stride);
+  if (step < 0) {
+    outptr->prefetch = -outptr->prefetch;
+  }
+
+  *arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
@@ -1,9 +1,13 @@
 #include "../headers/cdyar_darray.h"
 #include "../headers/cdyar_error.h"
+#include "../headers/cdyar_hashindex.h"
+#include "../headers/cdyar_memory.h"
+#include "../headers/cdyar_trace.h"
 #include <stdarg.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 /*
     internal function
@@ -12,23 +16,155 @@
     returns: (type: cdyar_bool) a boolean indicating whether the flag is valid
    or not
 */
-static void areFlagsValid(const cdyar_flag flags, cdyar_bool *outptr,
-                          cdyar_returncode *code) {
-  cdyar_flag MAX = 0;
-  cdyar_uintpow(2, CDYAR_DARRAY_FLAG_COUNT, &MAX, code);
-  MAX -= 1; // setting MAX to 2^(flag_count) - 1
-
-  if (*code != CDYAR_SUCCESSFUL) {
-    // an issue occured with cdyar_intpow, propagate the error upwards
-    return;
+static cdyar_bool areFlagsValid(const cdyar_flag flags) {
+  return (flags & ~CDYAR_DARRAY_FLAG_MASK) == 0 &&
+                 (flags & CDYAR_ARR_NUMERIC_MASK) <= CDYAR_ARR_DOUBLE
+             ? cdyar_true
+             : cdyar_false;
+}
+
+/*
+    internal function
+    check that the numeric type tag in the flags (if any) matches typesize
+*/
+static cdyar_bool cdyar_numericfits(const cdyar_flag flags,
+                                    const size_t typesize) {
+  switch (flags & CDYAR_ARR_NUMERIC_MASK) {
+  case CDYAR_ARR_INT32:
+    return typesize == sizeof(int32_t) ? cdyar_true : cdyar_false;
+  case CDYAR_ARR_INT64:
+    return typesize == sizeof(int64_t) ? cdyar_true : cdyar_false;
+  case CDYAR_ARR_FLOAT:
+    return typesize == sizeof(float) ? cdyar_true : cdyar_false;
+  case CDYAR_ARR_DOUBLE:
+    return typesize == sizeof(double) ? cdyar_true : cdyar_false;
+  default:
+    return cdyar_true;
   }
+}
+
+/*
+    internal function
+    whether the array asked for hugepage-backed buffers
+*/
+static cdyar_bool cdyar_hugepages(const cdyar_darray *arr) {
+  return (arr->flags & CDYAR_ARR_HUGEPAGES) ? cdyar_true : cdyar_false;
+}
+
+/*
+    internal function
+    whether the elements of the array can be moved with memcpy and memmove
+*/
+static cdyar_bool cdyar_relocatable(const cdyar_darray *arr) {
+  return (!arr->type || arr->type->relocatable) ? cdyar_true : cdyar_false;
+}
 
-  if (flags <= MAX) {
-    *outptr = cdyar_true;
+/*
+    internal function
+    move count elements from src to dst, which may overlap. relocatable
+   elements are moved in one memmove, the others one at a time through the
+   move hook, in the order that never overwrites an element before it moved
+*/
+static void cdyar_relocate(const cdyar_darray *arr, char *dst, char *src,
+                           size_t count) {
+  size_t typesize = arr->typesize;
+  if (cdyar_relocatable(arr)) {
+    memmove(dst, src, typesize * count);
+  } else if (dst < src) {
+    for (size_t i = 0; i < count; i++) {
+      arr->type->move(dst + (typesize * i), src + (typesize * i), typesize);
+    }
   } else {
-    *outptr = cdyar_false;
+    for (size_t i = count; i > 0; i--) {
+      arr->type->move(dst + (typesize * (i - 1)), src + (typesize * (i - 1)),
+                      typesize);
+    }
+  }
+}
+
+/*
+    internal function
+    copy count elements from src into the uninitialized memory at dst, deep
+   copies if the type has a copy hook. on failure the copies made so far are
+   destroyed again
+*/
+static cdyar_returncode cdyar_copyelements(const cdyar_darray *arr, char *dst,
+                                           const char *src, size_t count) {
+  size_t typesize = arr->typesize;
+  if (!arr->type || !arr->type->copy) {
+    memcpy(dst, src, typesize * count);
+    return CDYAR_SUCCESSFUL;
   }
 
+  for (size_t i = 0; i < count; i++) {
+    cdyar_returncode code = CDYAR_SUCCESSFUL;
+    arr->type->copy(dst + (typesize * i), src + (typesize * i), typesize,
+                    &code);
+    if (code != CDYAR_SUCCESSFUL) {
+      for (size_t j = 0; arr->type->destroy && j < i; j++) {
+        arr->type->destroy(dst + (typesize * j), typesize);
+      }
+      return code;
+    }
+  }
+  return CDYAR_SUCCESSFUL;
+}
+
+/*
+    internal function
+    destroy the elements from start to end (excluded) if the type has a
+   destroy hook
+*/
+static void cdyar_destroyrange(cdyar_darray *arr, size_t start, size_t end) {
+  if (!arr->type || !arr->type->destroy) {
+    return;
+  }
+  for (size_t i = start; i < end; i++) {
+    arr->type->destroy(cdyar_elementptr(arr, i), arr->typesize);
+  }
+}
+
+/*
+    internal function
+    reallocate the elements array to hold capacity elements and zero out the
+   new portion, the caller makes sure capacity * typesize doesn't overflow.
+   elements that can't be moved bitwise are moved into a fresh buffer one by
+   one instead of through realloc
+*/
+static void cdyar_growto(cdyar_darray *arr, const size_t capacity,
+                         cdyar_returncode *code) {
+  if (!cdyar_relocatable(arr)) {
+    char *elements_temp = cdyar_memory_calloc(
+        capacity * arr->typesize, arr->alignment, cdyar_hugepages(arr));
+    if (!elements_temp) {
+      *code = CDYAR_MEMORY_ERROR;
+      return;
+    }
+
+    // the elements before pending still live in the old buffer of an
+    // incremental resize
+    cdyar_relocate(arr, elements_temp + (arr->typesize * arr->pending),
+                   ((char *)arr->elements) + (arr->typesize * arr->pending),
+                   arr->length - arr->pending);
+    free(arr->elements);
+    arr->elements = elements_temp;
+    arr->capacity = capacity;
+    *code = CDYAR_SUCCESSFUL;
+    return;
+  }
+
+  void *elements_temp = cdyar_memory_realloc(
+      arr->elements, arr->capacity * arr->typesize, capacity * arr->typesize,
+      arr->alignment, cdyar_hugepages(arr));
+  if (!elements_temp) {
+    *code = CDYAR_MEMORY_ERROR;
+    return;
+  }
+
+  arr->elements = elements_temp;
+  memset(((char *)arr->elements) + (arr->typesize * arr->capacity), 0,
+         (arr->typesize * (capacity - arr->capacity)));
+  arr->capacity = capacity;
   *code = CDYAR_SUCCESSFUL;
 }
 
@@ -64,9 +200,165 @@ static void cdyar_default_resize_policy(cdyar_darray *arr,
     return;
   }
 
-  // TODO: Check overflow
-  cdyar_check_sizet_overflow(3, code, arr->capacity, 2, arr->typesize);
-  if (*code != CDYAR_SUCCESSFUL) {
+  // check overflow
+  size_t doubled, bytes;
+  if (cdyar_mul_overflows(arr->capacity, 2, &doubled) ||
+      cdyar_mul_overflows(doubled, arr->typesize, &bytes)) {
+    *code = CDYAR_SIZE_T_OVERFLOW;
+    return;
+  }
+
+  // make sure that length is actually equal to capacity
+  if (arr->length != arr->capacity) {
+    *code = CDYAR_INVALID_INPUT;
+    return;
+  }
+
+  // double the capacity
+  cdyar_growto(arr, doubled, code);
+}
+
+/*
+    internal function
+    current time in seconds, used to time the resizes of the adaptive policy
+*/
+static double cdyar_now(void) {
+  struct timespec ts;
+  if (!timespec_get(&ts, TIME_UTC)) {
+    return 0;
+  }
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+void cdyar_adaptive_resize_policy(cdyar_darray *arr, cdyar_returncode *code) {
+  // check code is not null
+  CDYAR_CHECK_CODE(code);
+
+  // check arr is not null
+  if (!arr) {
+    *code = CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+    return;
+  }
+
+  // check that there exists a static elements array inside the dynamic array
+  // structure
+  if (!arr->elements) {
+    *code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return;
+  }
+
+  // make sure that length is actually equal to capacity
+  if (arr->length != arr->capacity) {
+    *code = CDYAR_INVALID_INPUT;
+    return;
+  }
+
+  // every path grows by at most 2x, except fast arrays which only jump
+  // further when that doesn't overflow either
+  size_t doubled, bytes;
+  if (cdyar_mul_overflows(arr->capacity, 2, &doubled) ||
+      cdyar_mul_overflows(doubled, arr->typesize, &bytes)) {
+    *code = CDYAR_SIZE_T_OVERFLOW;
+    return;
+  }
+
+  cdyar_growthhistory *growth = &arr->growth;
+  double now = cdyar_now();
+  size_t capacity = doubled; // doubling unless the history says otherwise
+
+  if (growth->lastresize != 0 && now > growth->lastresize) {
+    // update the moving averages of the time between resizes and of the
+    // number of elements added per second. under geometric growth the
+    // interval of a steady appender keeps growing with the capacity, its
+    // rate doesn't
+    double interval = now - growth->lastresize;
+    double rate = (double)(arr->length - growth->lastlength) / interval;
+    double previous = growth->rate;
+    growth->interval = growth->interval == 0
+                           ? interval
+                           : (growth->interval + interval) / 2;
+    growth->rate = previous == 0 ? rate : (previous + rate) / 2;
+
+    cdyar_bool steady =
+        previous != 0 && rate < previous * 2 && rate * 2 > previous;
+
+    if (growth->interval < CDYAR_ADAPTIVE_FAST_INTERVAL && steady) {
+      // fast and steady, jump further ahead
+      if (arr->capacity <= SIZE_MAX / 4 / arr->typesize) {
+        capacity = arr->capacity * 4;
+      }
+    } else if (growth->interval > CDYAR_ADAPTIVE_SLOW_INTERVAL) {
+      // creeping, grow by what one more interval is likely to add at the
+      // current rate, in whole pages and never past doubling
+      double expected = growth->rate * growth->interval;
+      if (expected < (double)arr->capacity) {
+        size_t gained = expected < 1 ? 1 : (size_t)expected;
+        bytes = (arr->capacity + gained) * arr->typesize;
+        if (bytes <= SIZE_MAX - CDYAR_PAGE_SIZE) {
+          bytes = (bytes + CDYAR_PAGE_SIZE - 1) / CDYAR_PAGE_SIZE *
+                  CDYAR_PAGE_SIZE;
+          if (bytes / arr->typesize < capacity) {
+            capacity = bytes / arr->typesize;
+          }
+        }
+      }
+    }
+  }
+
+  cdyar_growto(arr, capacity, code);
+  if (*code == CDYAR_SUCCESSFUL) {
+    growth->lastresize = now;
+    growth->lastlength = arr->length;
+  }
+}
+
+/*
+    internal function
+    move up to count elements from the end of the old buffer's pending range
+   into the new buffer, freeing the old buffer once it is empty. the moved
+   elements are contiguous, so it is a single memcpy for relocatable types
+*/
+static void cdyar_migrate(cdyar_darray *arr, size_t count) {
+  if (!arr->oldelements) {
+    return;
+  }
+
+  if (count > arr->pending) {
+    count = arr->pending;
+  }
+  arr->pending -= count;
+  cdyar_relocate(arr, ((char *)arr->elements) + (arr->typesize * arr->pending),
+                 ((char *)arr->oldelements) + (arr->typesize * arr->pending),
+                 count);
+
+  if (arr->pending == 0) {
+    free(arr->oldelements);
+    arr->oldelements = NULL;
+  }
+}
+
+void cdyar_incremental_resize_policy(cdyar_darray *arr,
+                                     cdyar_returncode *code) {
+  // check code is not null
+  CDYAR_CHECK_CODE(code);
+
+  // check arr is not null
+  if (!arr) {
+    *code = CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+    return;
+  }
+
+  // check that there exists a static elements array inside the dynamic array
+  // structure
+  if (!arr->elements) {
+    *code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return;
+  }
+
+  size_t doubled, bytes;
+  if (cdyar_mul_overflows(arr->capacity, 2, &doubled) ||
+      cdyar_mul_overflows(doubled, arr->typesize, &bytes)) {
+    *code = CDYAR_SIZE_T_OVERFLOW;
     return;
   }
 
@@ -76,24 +368,52 @@ static void cdyar_default_resize_policy(cdyar_darray *arr,
     return;
   }
 
-  // resize the array
+  // a previous migration can only still be running if elements were
+  // removed in between, finish it so there is a single old buffer
+  cdyar_migrate(arr, arr->pending);
+
+  // calloc hands back fresh zero pages for large sizes, so the new buffer
+  // does not have to be zeroed by hand in one go (unless it is aligned)
   void *elements_temp =
-      realloc(arr->elements, arr->capacity * arr->typesize * 2);
+      cdyar_memory_calloc(bytes, arr->alignment, cdyar_hugepages(arr));
   if (!elements_temp) {
     *code = CDYAR_MEMORY_ERROR;
     return;
   }
 
-  // zero out the new portion of the array
+  // every current element stays in the old buffer until it is migrated
+  arr->oldelements = arr->elements;
+  arr->pending = arr->length;
   arr->elements = elements_temp;
-  memset(((char *)arr->elements) + (arr->typesize * arr->capacity), 0,
-         (arr->typesize * arr->capacity));
-
-  // make sure to double the capacity
   arr->capacity *= 2;
   *code = CDYAR_SUCCESSFUL;
 }
 
+cdyar_returncode cdyar_finishresize(cdyar_darray *arr) {
+  // check arr is not null
+  if (!arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  cdyar_migrate(arr, arr->pending);
+  *arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+/*
+    internal function
+    free the returncode of a dynamic array, unless it is embedded in the
+   structure itself (CDYAR_ARR_INLINE_CODE)
+*/
+static void cdyar_freecode(cdyar_darray *arr, cdyar_returncode *code) {
+  if (code != &arr->status) {
+    free(code);
+  }
+}
+
 /*
     allocate memory for a new dynamic array
     args: 1) const size_t typesize  : the size of the type to be stored in the
@@ -108,70 +428,98 @@ cdyar_returncode cdyar_narr(const size_t typesize, const size_t capacity,
                             const cdyar_resizepolicy policy,
                             const cdyar_typehandler handler,
                             const cdyar_flag flags, cdyar_darray *outptr) {
+  return cdyar_narr_aligned(typesize, capacity, CDYAR_DEFAULT_ALIGNMENT,
+                            policy, handler, flags, outptr);
+}
+
+cdyar_returncode cdyar_narr_aligned(const size_t typesize,
+                                    const size_t capacity,
+                                    const size_t alignment,
+                                    const cdyar_resizepolicy policy,
+                                    const cdyar_typehandler handler,
+                                    const cdyar_flag flags,
+                                    cdyar_darray *outptr) {
 
   // create a cdyar_returncode for the dynamic array so that
-  cdyar_returncode *code = malloc(sizeof(cdyar_returncode));
-  if (!code) {
-    return CDYAR_MEMORY_ERROR;
+  // it can track its own status, either embedded in the structure itself
+  // or in a separate allocation
+  cdyar_returncode *code;
+  if (flags & CDYAR_ARR_INLINE_CODE) {
+    code = &outptr->status;
+  } else {
+    code = malloc(sizeof(cdyar_returncode));
+    if (!code) {
+      return CDYAR_MEMORY_ERROR;
+    }
   }
   *code = CDYAR_SUCCESSFUL; // default value of code
 
   // make sure capacity passed is positive
   if (capacity == 0) {
-    free(code);
+    cdyar_freecode(outptr, code);
     return CDYAR_INVALID_INPUT;
   }
 
   // make sure typesize if a valid size
   if (typesize == 0) {
-    free(code);
+    cdyar_freecode(outptr, code);
     return CDYAR_INVALID_INPUT;
   }
 
   // make sure there is no overflow
   if (capacity > SIZE_MAX / typesize) {
-    free(code);
+    cdyar_freecode(outptr, code);
     return CDYAR_SIZE_T_OVERFLOW;
   }
 
-  // make sure the flags are valid
-  cdyar_bool flags_valid;
-  areFlagsValid(flags, &flags_valid, code);
-  cdyar_returncode tempcode = *code;
-  if (*code != CDYAR_SUCCESSFUL) {
-    // an issue occured in areFlagsValid, propagate the error upwards
-    free(code);
-    return tempcode;
+  // make sure the alignment is a power of two (or the default)
+  if (!cdyar_memory_validalignment(alignment)) {
+    cdyar_freecode(outptr, code);
+    return CDYAR_INVALID_INPUT;
   }
 
-  if (!flags_valid) {
-    free(code);
+  // make sure the flags are valid
+  if (!areFlagsValid(flags) || !cdyar_numericfits(flags, typesize)) {
+    cdyar_freecode(outptr, code);
     return CDYAR_INVALID_INPUT;
   }
 
   // make sure handler is not null
   if (!handler) {
-    free(code);
+    cdyar_freecode(outptr, code);
     return CDYAR_INVALID_INPUT;
   }
 
   // allocate memory for the new elements array inside the dynamic array
   // structure
-  outptr->elements = malloc(capacity * typesize);
+  // with all the elements zeroed out
+  outptr->elements =
+      cdyar_memory_calloc(capacity * typesize, alignment,
+                          (flags & CDYAR_ARR_HUGEPAGES) ? cdyar_true
+                                                        : cdyar_false);
   if (!outptr->elements) {
-    free(code);
+    cdyar_freecode(outptr, code);
     return CDYAR_MEMORY_ERROR;
   }
 
-  // zero out all the elements inside the inner array
-  memset(outptr->elements, 0, capacity * typesize);
-
   // set properties
   outptr->capacity = capacity;
   outptr->typesize = typesize;
+  outptr->alignment = alignment;
   outptr->flags = flags;
   outptr->length = 0;
   outptr->code = code;
+  outptr->index = NULL;
+  outptr->trace = NULL;
+  outptr->refcount = NULL;
+  outptr->oldelements = NULL;
+  outptr->pending = 0;
+  outptr->type = NULL;
+  memset(&outptr->growth, 0, sizeof(cdyar_growthhistory));
+#ifdef CDYAR_STATS
+  memset(&outptr->stats, 0, sizeof(cdyar_stats));
+#endif
+  CDYAR_STAT_PEAK(outptr);
 
   // assign resize policy
   if (policy == CDYAR_DEFAULT_RESIZE_POLICY) {
@@ -200,20 +548,63 @@ cdyar_returncode cdyar_darr(cdyar_darray *arr) {
 
   CDYAR_CHECK_CODE(arr->code);
 
-  // if the inner array exists, free it
+  // drop the hash index if one is attached
+  if (arr->index) {
+    free(arr->index->slots);
+    free(arr->index);
+    arr->index = NULL;
+  }
+
+  // record the end of the trace if one is attached
+  if (arr->trace) {
+    cdyar_returncode code = *arr->code;
+    cdyar_detachtrace(arr);
+    *arr->code = code;
+  }
+
+  // if the inner array exists, free it, unless a clone still uses it
   if (arr->elements) {
-    free(arr->elements);
+    if (!arr->refcount || atomic_fetch_sub(arr->refcount, 1) == 1) {
+      cdyar_destroyrange(arr, 0, arr->length);
+      free(arr->elements);
+      free(arr->refcount);
+    }
+    arr->refcount = NULL;
   } else {
     *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
   }
 
+  // drop the old buffer of an unfinished incremental resize
+  free(arr->oldelements);
+  arr->oldelements = NULL;
+  arr->pending = 0;
+
   // free code
   cdyar_returncode tempcode = *arr->code;
-  free(arr->code);
+  cdyar_freecode(arr, arr->code);
 
   return tempcode;
 }
 
+/*
+    internal function
+    store the value into the element at index, which holds no value: deep
+   copied with the copy hook if the type has one, through the type handler
+   otherwise. a failed copy leaves the element zeroed
+*/
+static void cdyar_assign(cdyar_darray *arr, size_t index, void *valueptr) {
+  void *element = cdyar_elementptr(arr, index);
+  if (arr->type && arr->type->copy) {
+    arr->type->copy(element, valueptr, arr->typesize, arr->code);
+    if (*arr->code != CDYAR_SUCCESSFUL) {
+      memset(element, 0, arr->typesize);
+    }
+    return;
+  }
+  arr->handler(element, valueptr, CDYAR_DIRECTION_ASSIGN_RIGHT_TO_LEFT,
+               arr->typesize, arr->code);
+}
+
 /*
     safely set an element at a particular index in a dynamic array to a value
     args: 1) cdyar_darray* arr     : a pointer to the dynamic array
@@ -227,7 +618,7 @@ cdyar_returncode cdyar_set(cdyar_darray *arr, const size_t index,
                            void *valueptr) {
 
   // check that arr is not null
-  if (!arr) {
+  if (CDYAR_BOUNDARY_FAILS(!arr)) {
     return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
   }
 
@@ -235,59 +626,91 @@ cdyar_returncode cdyar_set(cdyar_darray *arr, const size_t index,
   CDYAR_CHECK_CODE(arr->code);
 
   // check that valueptr is not null
-  if (!valueptr) {
+  if (CDYAR_BOUNDARY_FAILS(!valueptr)) {
     *arr->code = CDYAR_INVALID_INPUT;
     return CDYAR_INVALID_INPUT;
   }
 
   // check that typesize is not zero
-  if (arr->typesize == 0) {
+  if (CDYAR_STRUCTURE_FAILS(arr->typesize == 0)) {
     *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
     return CDYAR_CORRUPTED_DYNAMIC_ARR;
   }
 
   // check for typesize overflow
-  if (index > SIZE_MAX / arr->typesize) {
+  if (CDYAR_STRUCTURE_FAILS(index > SIZE_MAX / arr->typesize)) {
     *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
     return CDYAR_CORRUPTED_DYNAMIC_ARR;
   }
 
   // check that an elements array actually exists within the dynamic array
-  if (!arr->elements) {
+  if (CDYAR_STRUCTURE_FAILS(!arr->elements)) {
     *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
     return CDYAR_CORRUPTED_DYNAMIC_ARR;
   }
 
   // make sure a resize policy for the dynamic array exists
-  if (!arr->policy) {
+  if (CDYAR_STRUCTURE_FAILS(!arr->policy)) {
     *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
     return CDYAR_CORRUPTED_DYNAMIC_ARR;
   }
 
   // make sure a type handler for the dynamic array exists
-  if (!arr->handler) {
+  if (CDYAR_STRUCTURE_FAILS(!arr->handler)) {
     *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
     return CDYAR_CORRUPTED_DYNAMIC_ARR;
   }
 
+  // a write is about to happen, the buffer must not be shared with a clone
+  if (arr->refcount && index <= arr->length) {
+    cdyar_unshare(arr);
+    if (*arr->code != CDYAR_SUCCESSFUL) {
+      return *arr->code;
+    }
+  }
+
+  CDYAR_STAT_ADD(arr, sets, 1);
+
+  // pay off part of an incremental resize in progress
+  cdyar_migrate(arr, CDYAR_INCREMENTAL_RESIZE_STEP);
+
   //make sure that the user is either adding a new element right after the position of the last element
   //or that he is replacing an old element
-  if(index > arr->length) {
+  if(CDYAR_BOUNDARY_FAILS(index > arr->length)) {
       *arr->code = CDYAR_ARR_OUT_OF_BOUNDS;
       return CDYAR_ARR_OUT_OF_BOUNDS;
   } else if(index < arr->length) {
       //no resize needed, simply just do the assignment using the array's handler
-      arr->handler(((char *)(arr->elements)) + (arr->typesize * index), valueptr,
-                    CDYAR_DIRECTION_ASSIGN_RIGHT_TO_LEFT, arr->typesize,
-                    arr->code);
+      //the old key has to leave the hash index before it is overwritten
+      cdyar_hashindex_erase(arr, index);
+      //the replaced element releases what it owns first
+      cdyar_destroyrange(arr, index, index + 1);
+      cdyar_assign(arr, index, valueptr);
+      CDYAR_STAT_ADD(arr, handler_calls, 1);
+      if(arr->index && *arr->code == CDYAR_SUCCESSFUL) {
+          *arr->code = cdyar_hashindex_insert(arr, index);
+      }
   } else {
      //user is adding appending a new element to the array
+     //clear the status left by a previous call, it must not block the append below
+     *arr->code = CDYAR_SUCCESSFUL;
+
      //make sure there is enough capacity
      if(arr->length == arr->capacity) {
          //currently, length equals capacity, so adding a new element would make length exceed capacity
          //thus, a resize is needed
          //invoke the array resizepolicy
          arr->policy(arr, arr->code);
+
+         //count the resize if the policy actually grew the array
+         if(*arr->code == CDYAR_SUCCESSFUL && arr->capacity != arr->length) {
+             CDYAR_STAT_ADD(arr, resizes, 1);
+             CDYAR_STAT_ADD(arr, resize_bytes, arr->length * arr->typesize);
+             CDYAR_STAT_PEAK(arr);
+             if(arr->trace) {
+                 cdyar_trace_record(arr->trace, CDYAR_TRACE_RESIZE, arr->length, arr->capacity);
+             }
+         }
      }
 
      //only proceed if the resize was successful
@@ -295,20 +718,28 @@ cdyar_returncode cdyar_set(cdyar_darray *arr, const size_t index,
          //resize was successful
          //perform the assignment using the array's handler
          //increment the length by one
-         arr->handler(((char *)(arr->elements)) + (arr->typesize * index), valueptr,
-                             CDYAR_DIRECTION_ASSIGN_RIGHT_TO_LEFT, arr->typesize,
-                             arr->code);
+         cdyar_assign(arr, index, valueptr);
+         CDYAR_STAT_ADD(arr, handler_calls, 1);
          arr->length += 1;
+
+         //index the new element if the array carries a hash index
+         if(arr->index && *arr->code == CDYAR_SUCCESSFUL) {
+             *arr->code = cdyar_hashindex_insert(arr, index);
+         }
      }
   }
 
+  if(arr->trace && *arr->code == CDYAR_SUCCESSFUL) {
+      cdyar_trace_record(arr->trace, CDYAR_TRACE_SET, index, 0);
+  }
+
   return *arr->code;
 }
 
 static
 void*
 cdyar_getptr(cdyar_darray* arr, size_t index) {
-   return ((char*) arr->elements) + (arr->typesize * index);
+   return cdyar_elementptr(arr, index);
 }
 
 static
@@ -328,17 +759,14 @@ cdyar_shiftleft(cdyar_darray* arr, size_t start){
         return CDYAR_INVALID_INPUT;
     }
 
-    //starting the left shift operation
-    size_t left_index = start;
-    size_t right_index = start + 1;
+    //the elements after start have to be in a single buffer to move them at once
+    cdyar_migrate(arr, arr->pending);
 
-    while(right_index != arr->length) {
-        //copy the element at the right_index into left_index
-        memcpy(cdyar_getptr(arr, left_index), cdyar_getptr(arr, right_index), arr->typesize);
-
-        left_index++;
-        right_index++;
-    }
+    //move every element after start one step to the left, in a single memmove
+    //unless the type needs its move hook
+    cdyar_relocate(arr, cdyar_getptr(arr, start), cdyar_getptr(arr, start + 1),
+                   arr->length - 1 - start);
+    CDYAR_STAT_ADD(arr, shift_moves, arr->length - 1 - start);
 
     *arr->code = CDYAR_SUCCESSFUL;
     return CDYAR_SUCCESSFUL;
@@ -347,7 +775,7 @@ cdyar_shiftleft(cdyar_darray* arr, size_t start){
 cdyar_returncode
 cdyar_rm(cdyar_darray* arr, const size_t index) {
    //check that arr is not null
-   if(!arr) {
+   if(CDYAR_BOUNDARY_FAILS(!arr)) {
        return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
    }
 
@@ -355,15 +783,28 @@ cdyar_rm(cdyar_darray* arr, const size_t index) {
    CDYAR_CHECK_CODE(arr->code);
 
    //check for out of bounds
-   if(index >= arr->length) {
+   if(CDYAR_BOUNDARY_FAILS(index >= arr->length)) {
       *arr->code = CDYAR_INVALID_INPUT;
       return CDYAR_INVALID_INPUT;
    }
+   CDYAR_STAT_ADD(arr, rms, 1);
+
+   //removing shifts elements around, the buffer must not be shared with a clone
+   if(cdyar_unshare(arr) != CDYAR_SUCCESSFUL) {
+       return *arr->code;
+   }
+
+   //the element's key has to leave the hash index while it is still there
+   cdyar_hashindex_erase(arr, index);
+   cdyar_destroyrange(arr, index, index + 1);
 
    if(index == arr->length - 1) {
        //last element
        //simply jsut decrease length by one
        arr->length--;
+       if(arr->trace) {
+           cdyar_trace_record(arr->trace, CDYAR_TRACE_RM, index, 0);
+       }
        *arr->code = CDYAR_SUCCESSFUL;
        return CDYAR_SUCCESSFUL;
    }
@@ -376,10 +817,67 @@ cdyar_rm(cdyar_darray* arr, const size_t index) {
    }
 
    arr->length--;
+
+   //every element after index moved one step to the left
+   cdyar_hashindex_shift(arr, index);
+   if(arr->trace) {
+       cdyar_trace_record(arr->trace, CDYAR_TRACE_RM, index, 0);
+   }
    /*arr->code = CDYAR_SUCCESSFUL */ //no need to do that since cdyar_shiftleft will set the code
    return CDYAR_SUCCESSFUL;
 }
 
+cdyar_returncode
+cdyar_swaprm(cdyar_darray* arr, const size_t index) {
+   //check that arr is not null
+   if(CDYAR_BOUNDARY_FAILS(!arr)) {
+       return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+   }
+
+   //check that code is not null
+   CDYAR_CHECK_CODE(arr->code);
+
+   //check for out of bounds
+   if(CDYAR_BOUNDARY_FAILS(index >= arr->length)) {
+      *arr->code = CDYAR_INVALID_INPUT;
+      return CDYAR_INVALID_INPUT;
+   }
+
+   //check that an elements array actually exists within the dynamic array
+   if(CDYAR_STRUCTURE_FAILS(!arr->elements)) {
+      *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+      return CDYAR_CORRUPTED_DYNAMIC_ARR;
+   }
+
+   CDYAR_STAT_ADD(arr, rms, 1);
+
+   //moving the last element writes into the buffer, it must not be shared with a clone
+   if(cdyar_unshare(arr) != CDYAR_SUCCESSFUL) {
+       return *arr->code;
+   }
+
+   size_t last = arr->length - 1;
+   cdyar_hashindex_erase(arr, index);
+   cdyar_destroyrange(arr, index, index + 1);
+
+   if(index != last) {
+       //move the last element into the hole, it keeps its key but changes position
+       cdyar_hashindex_erase(arr, last);
+       cdyar_relocate(arr, cdyar_getptr(arr, index), cdyar_getptr(arr, last), 1);
+   }
+
+   arr->length--;
+
+   *arr->code = CDYAR_SUCCESSFUL;
+   if(index != last) {
+       *arr->code = cdyar_hashindex_insert(arr, index);
+   }
+   if(arr->trace) {
+       cdyar_trace_record(arr->trace, CDYAR_TRACE_SWAPRM, index, 0);
+   }
+   return *arr->code;
+}
+
 
 
 /*
@@ -391,7 +889,7 @@ cdyar_rm(cdyar_darray* arr, const size_t index) {
 cdyar_returncode cdyar_get(const cdyar_darray *arr, const size_t index,
                            void *outptr) {
   // check arr is not null
-  if (!arr) {
+  if (CDYAR_BOUNDARY_FAILS(!arr)) {
     return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
   }
 
@@ -399,53 +897,128 @@ cdyar_returncode cdyar_get(const cdyar_darray *arr, const size_t index,
   CDYAR_CHECK_CODE(arr->code);
 
   // check *outptr is not null
-  if (!outptr) {
+  if (CDYAR_BOUNDARY_FAILS(!outptr)) {
     *arr->code = CDYAR_INVALID_INPUT;
     return CDYAR_INVALID_INPUT;
   }
 
   // check that the typesize is not zero
-  if (arr->typesize == 0) {
+  if (CDYAR_STRUCTURE_FAILS(arr->typesize == 0)) {
     *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
     return CDYAR_CORRUPTED_DYNAMIC_ARR;
   }
 
   // chcek for typesize overflow
-  if (index > SIZE_MAX / arr->typesize) {
+  if (CDYAR_STRUCTURE_FAILS(index > SIZE_MAX / arr->typesize)) {
     *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
     return CDYAR_CORRUPTED_DYNAMIC_ARR;
   }
 
   // check that an elements array actually exists within the static array
-  if (!arr->elements) {
+  if (CDYAR_STRUCTURE_FAILS(!arr->elements)) {
     *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
     return CDYAR_CORRUPTED_DYNAMIC_ARR;
   }
 
   // check that there is a handler function in the dynamic array
-  if (!arr->handler) {
+  if (CDYAR_STRUCTURE_FAILS(!arr->handler)) {
     *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
     return CDYAR_CORRUPTED_DYNAMIC_ARR;
   }
 
   // bounds checking
-  if (index >= arr->capacity) {
+  if (CDYAR_BOUNDARY_FAILS(index >= arr->capacity)) {
     *arr->code = CDYAR_ARR_OUT_OF_BOUNDS;
     return CDYAR_ARR_OUT_OF_BOUNDS;
   }
 
+  // pay off part of an incremental resize in progress. this moves elements
+  // between buffers without changing the array's logical contents, so it is
+  // done even through a const pointer
+  cdyar_migrate((cdyar_darray *)arr, CDYAR_INCREMENTAL_RESIZE_STEP);
+
   // assign outptr to a pointer to the element in question in the array
-  // void ptr converted to char* to suppress compiler warnings
-  arr->handler(((char *)(arr->elements)) + (arr->typesize * index), outptr,
+  arr->handler(cdyar_elementptr(arr, index), outptr,
                CDYAR_DIRECTION_ASSIGN_LEFT_TO_RIGHT, arr->typesize, arr->code);
 
+  // counters are bookkeeping, not part of the array's logical contents, so
+  // they are updated even through a const pointer
+  CDYAR_STAT_ADD((cdyar_darray *)arr, gets, 1);
+  CDYAR_STAT_ADD((cdyar_darray *)arr, handler_calls, 1);
+
+  if (arr->trace && *arr->code == CDYAR_SUCCESSFUL) {
+    cdyar_trace_record(arr->trace, CDYAR_TRACE_GET, index, 0);
+  }
+
   /**code=CDYAR_SUCCESSFUL*/ // uneccessary since handler will determine code
                              // anyways + it could hide handler failure`
   return *arr->code;
 }
 
-cdyar_returncode cdyar_setflags(cdyar_darray *arr, const cdyar_flag flags) {
+cdyar_returncode cdyar_clone(cdyar_darray *src, cdyar_darray *outptr) {
+  // check src is not null
+  if (!src) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(src->code);
+
+  // check outptr is not null
+  if (!outptr || outptr == src) {
+    *src->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // check that an elements array actually exists within the dynamic array
+  if (!src->elements) {
+    *src->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // clones share a single buffer, an incremental resize must be done first
+  cdyar_migrate(src, src->pending);
 
+  // the clone needs a cdyar_returncode of its own
+  cdyar_returncode *code;
+  if (src->flags & CDYAR_ARR_INLINE_CODE) {
+    code = &outptr->status;
+  } else {
+    code = malloc(sizeof(cdyar_returncode));
+    if (!code) {
+      *src->code = CDYAR_MEMORY_ERROR;
+      return CDYAR_MEMORY_ERROR;
+    }
+  }
+
+  // the first clone turns the buffer into a shared one
+  if (!src->refcount) {
+    src->refcount = malloc(sizeof(atomic_size_t));
+    if (!src->refcount) {
+      cdyar_freecode(outptr, code);
+      *src->code = CDYAR_MEMORY_ERROR;
+      return CDYAR_MEMORY_ERROR;
+    }
+    atomic_init(src->refcount, 1);
+  }
+  atomic_fetch_add(src->refcount, 1);
+
+  // share everything but the return code, the hash index and the trace
+  *outptr = *src;
+  outptr->code = code;
+  *outptr->code = CDYAR_SUCCESSFUL;
+  outptr->index = NULL;
+  outptr->trace = NULL;
+#ifdef CDYAR_STATS
+  memset(&outptr->stats, 0, sizeof(cdyar_stats));
+#endif
+  CDYAR_STAT_PEAK(outptr);
+
+  *src->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_unshare(cdyar_darray *arr) {
   // check arr is not null
   if (!arr) {
     return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
@@ -454,15 +1027,70 @@ cdyar_returncode cdyar_setflags(cdyar_darray *arr, const cdyar_flag flags) {
   // check code is not null
   CDYAR_CHECK_CODE(arr->code);
 
-  // make sure the flags are valid
-  cdyar_bool flags_valid = cdyar_false;
-  areFlagsValid(flags, &flags_valid, arr->code);
-  if (*arr->code != CDYAR_SUCCESSFUL) {
-    // an issue occurred in areFlagsValid, propagte the error upwards
-    return *arr->code;
+  // nothing to do for a buffer that was never shared
+  if (!arr->refcount) {
+    *arr->code = CDYAR_SUCCESSFUL;
+    return CDYAR_SUCCESSFUL;
   }
 
-  if (!flags_valid) {
+  // every clone has already been destroyed, the buffer is ours again
+  if (atomic_load(arr->refcount) == 1) {
+    free(arr->refcount);
+    arr->refcount = NULL;
+    *arr->code = CDYAR_SUCCESSFUL;
+    return CDYAR_SUCCESSFUL;
+  }
+
+  // check that an elements array actually exists within the dynamic array
+  if (!arr->elements) {
+    *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // copy the elements, the rest of the capacity is zeroed like a fresh array
+  void *elements_temp = cdyar_memory_alloc(arr->capacity * arr->typesize,
+                                           arr->alignment,
+                                           cdyar_hugepages(arr));
+  if (!elements_temp) {
+    *arr->code = CDYAR_MEMORY_ERROR;
+    return CDYAR_MEMORY_ERROR;
+  }
+  // owning elements are deep-copied, the clones keep the originals
+  cdyar_returncode code =
+      cdyar_copyelements(arr, elements_temp, arr->elements, arr->length);
+  if (code != CDYAR_SUCCESSFUL) {
+    free(elements_temp);
+    *arr->code = code;
+    return code;
+  }
+  memset(((char *)elements_temp) + (arr->length * arr->typesize), 0,
+         (arr->capacity - arr->length) * arr->typesize);
+
+  // release our reference. if the other holders let go while we were
+  // copying, we were the last one and the old buffer has to be freed
+  if (atomic_fetch_sub(arr->refcount, 1) == 1) {
+    free(arr->elements);
+    free(arr->refcount);
+  }
+
+  arr->elements = elements_temp;
+  arr->refcount = NULL;
+  *arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_setflags(cdyar_darray *arr, const cdyar_flag flags) {
+
+  // check arr is not null
+  if (!arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // make sure the flags are valid
+  if (!areFlagsValid(flags) || !cdyar_numericfits(flags, arr->typesize)) {
     *arr->code = CDYAR_INVALID_INPUT;
     return CDYAR_INVALID_INPUT;
   }
@@ -496,3 +1124,437 @@ cdyar_returncode cdyar_setpolicy(cdyar_darray *arr,
   *arr->code = CDYAR_SUCCESSFUL;
   return CDYAR_SUCCESSFUL;
 }
+
+cdyar_returncode cdyar_settype(cdyar_darray *arr, const cdyar_typedesc *type) {
+
+  // check that arr is not null
+  if (!arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check that code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // elements that can't be moved bitwise need a way to be moved
+  if (type && !type->relocatable && !type->move) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // assign new type descriptor and indicate success
+  arr->type = type;
+
+  *arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+/*
+    internal function
+    grow the elements array once so that it holds at least capacity
+   elements. the buffer is unshared and any incremental resize is finished
+   first, since the caller is about to write into it
+*/
+static cdyar_returncode cdyar_reserveto(cdyar_darray *arr,
+                                        const size_t capacity) {
+  cdyar_migrate(arr, arr->pending);
+  if (cdyar_unshare(arr) != CDYAR_SUCCESSFUL) {
+    return *arr->code;
+  }
+
+  // already large enough
+  if (capacity <= arr->capacity) {
+    *arr->code = CDYAR_SUCCESSFUL;
+    return CDYAR_SUCCESSFUL;
+  }
+
+  // check overflow
+  size_t bytes;
+  if (cdyar_mul_overflows(capacity, arr->typesize, &bytes)) {
+    *arr->code = CDYAR_SIZE_T_OVERFLOW;
+    return CDYAR_SIZE_T_OVERFLOW;
+  }
+
+  size_t oldcapacity = arr->capacity;
+  cdyar_growto(arr, capacity, arr->code);
+  if (*arr->code != CDYAR_SUCCESSFUL) {
+    return *arr->code;
+  }
+
+  CDYAR_STAT_ADD(arr, resizes, 1);
+  CDYAR_STAT_ADD(arr, resize_bytes, arr->length * arr->typesize);
+  CDYAR_STAT_PEAK(arr);
+  if (arr->trace) {
+    cdyar_trace_record(arr->trace, CDYAR_TRACE_RESIZE, oldcapacity, capacity);
+  }
+  return CDYAR_SUCCESSFUL;
+}
+
+/*
+    internal function
+    capacity to grow to when count elements are added to an array at once:
+   doubling keeps repeated bulk appends amortized, unless the elements
+   need even more
+*/
+static size_t cdyar_bulkcapacity(const cdyar_darray *arr, size_t needed) {
+  if (needed <= arr->capacity) {
+    return arr->capacity;
+  }
+  if (arr->capacity <= SIZE_MAX / 2 && arr->capacity * 2 > needed) {
+    return arr->capacity * 2;
+  }
+  return needed;
+}
+
+/*
+    internal function
+    check the second array of a two-array operation, reporting problems in
+   the first one's code
+*/
+static cdyar_returncode cdyar_checkpair(cdyar_darray *dst,
+                                        const cdyar_darray *src) {
+  // check src is not null
+  if (!src) {
+    *dst->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(src->code);
+
+  // check that both arrays actually have elements arrays
+  if (!dst->elements || !src->elements) {
+    *dst->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // elements can only be moved between arrays of the same type size, and
+  // the hooks that built them must be the ones that copy and destroy them
+  if (dst->typesize != src->typesize || dst->type != src->type) {
+    *dst->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  return CDYAR_SUCCESSFUL;
+}
+
+/*
+    internal function
+    record count appended elements in the trace of an array, starting at
+   index start, so that replays see the same growth
+*/
+static void cdyar_traceappend(cdyar_darray *arr, size_t start, size_t count) {
+  if (!arr->trace) {
+    return;
+  }
+  for (size_t i = 0; i < count; i++) {
+    cdyar_trace_record(arr->trace, CDYAR_TRACE_SET, start + i, 0);
+  }
+}
+
+cdyar_returncode cdyar_reserve(cdyar_darray *arr, const size_t capacity) {
+  // check arr is not null
+  if (!arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // check that an elements array actually exists within the dynamic array
+  if (!arr->elements) {
+    *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  return cdyar_reserveto(arr, capacity);
+}
+
+cdyar_returncode cdyar_reserve_parallel(cdyar_darray *arr,
+                                        const size_t capacity,
+                                        const size_t threads) {
+  // check arr is not null
+  if (!arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // check that an elements array actually exists within the dynamic array
+  if (!arr->elements) {
+    *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // the workers copy bytes, elements that need their hooks to be moved or
+  // copied out of a shared buffer take the single-threaded path
+  if (arr->type && (arr->type->copy || !arr->type->relocatable)) {
+    return cdyar_reserve(arr, capacity);
+  }
+
+  // the elements are copied out of a single buffer
+  cdyar_migrate(arr, arr->pending);
+
+  // already large enough
+  if (capacity <= arr->capacity) {
+    *arr->code = CDYAR_SUCCESSFUL;
+    return CDYAR_SUCCESSFUL;
+  }
+
+  // check overflow
+  size_t bytes;
+  if (cdyar_mul_overflows(capacity, arr->typesize, &bytes)) {
+    *arr->code = CDYAR_SIZE_T_OVERFLOW;
+    return CDYAR_SIZE_T_OVERFLOW;
+  }
+
+  // the workers copy the elements over and zero everything after them
+  void *elements_temp = cdyar_memory_alloc_parallel(
+      bytes, arr->alignment, cdyar_hugepages(arr), arr->elements,
+      arr->length * arr->typesize, threads);
+  if (!elements_temp) {
+    *arr->code = CDYAR_MEMORY_ERROR;
+    return CDYAR_MEMORY_ERROR;
+  }
+
+  // a shared buffer stays with the clones, ours was copied out of it
+  if (!arr->refcount || atomic_fetch_sub(arr->refcount, 1) == 1) {
+    free(arr->elements);
+    free(arr->refcount);
+  }
+  arr->refcount = NULL;
+
+  size_t oldcapacity = arr->capacity;
+  arr->elements = elements_temp;
+  arr->capacity = capacity;
+
+  CDYAR_STAT_ADD(arr, resizes, 1);
+  CDYAR_STAT_ADD(arr, resize_bytes, arr->length * arr->typesize);
+  CDYAR_STAT_PEAK(arr);
+  if (arr->trace) {
+    cdyar_trace_record(arr->trace, CDYAR_TRACE_RESIZE, oldcapacity, capacity);
+  }
+
+  *arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+/*
+    internal function
+    append the elements of src to dst, copying them, or moving them out of
+   src (which is left empty) when transfer is set. the pair has been checked
+*/
+static cdyar_returncode cdyar_appendelements(cdyar_darray *dst,
+                                             cdyar_darray *src,
+                                             cdyar_bool transfer) {
+  // remember the count now, src may be dst itself
+  size_t start = dst->length;
+  size_t count = src->length;
+  if (count > SIZE_MAX - start) {
+    *dst->code = CDYAR_SIZE_T_OVERFLOW;
+    return CDYAR_SIZE_T_OVERFLOW;
+  }
+
+  // the elements are copied out of a single buffer
+  cdyar_migrate(src, src->pending);
+
+  // grow once for all of the new elements
+  if (cdyar_reserveto(dst, cdyar_bulkcapacity(dst, start + count)) !=
+      CDYAR_SUCCESSFUL) {
+    return *dst->code;
+  }
+
+  char *gap = ((char *)dst->elements) + (dst->typesize * start);
+  if (transfer) {
+    cdyar_relocate(dst, gap, src->elements, count);
+    src->length = 0;
+  } else {
+    cdyar_returncode code = cdyar_copyelements(dst, gap, src->elements, count);
+    if (code != CDYAR_SUCCESSFUL) {
+      *dst->code = code;
+      return code;
+    }
+  }
+  dst->length = start + count;
+  CDYAR_STAT_ADD(dst, sets, count);
+
+  // index the new elements if the array carries a hash index
+  for (size_t i = start; dst->index && i < dst->length; i++) {
+    *dst->code = cdyar_hashindex_insert(dst, i);
+    if (*dst->code != CDYAR_SUCCESSFUL) {
+      return *dst->code;
+    }
+  }
+
+  cdyar_traceappend(dst, start, count);
+
+  *dst->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_append(cdyar_darray *dst, cdyar_darray *src) {
+  // check dst is not null
+  if (!dst) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(dst->code);
+
+  if (cdyar_checkpair(dst, src) != CDYAR_SUCCESSFUL) {
+    return *dst->code;
+  }
+
+  return cdyar_appendelements(dst, src, cdyar_false);
+}
+
+cdyar_returncode cdyar_splice(cdyar_darray *dst, const size_t index,
+                              cdyar_darray *src, const size_t start,
+                              const size_t count) {
+  // check dst is not null
+  if (!dst) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(dst->code);
+
+  if (cdyar_checkpair(dst, src) != CDYAR_SUCCESSFUL) {
+    return *dst->code;
+  }
+
+  // moving elements within one array is not a splice
+  if (dst == src) {
+    *dst->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // bounds checking, written so that start + count can't overflow
+  if (index > dst->length || start > src->length ||
+      count > src->length - start) {
+    *dst->code = CDYAR_ARR_OUT_OF_BOUNDS;
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+
+  if (count == 0) {
+    *dst->code = CDYAR_SUCCESSFUL;
+    return CDYAR_SUCCESSFUL;
+  }
+
+  // both arrays are written to, so neither may share its buffer
+  cdyar_migrate(src, src->pending);
+  if (cdyar_unshare(src) != CDYAR_SUCCESSFUL) {
+    *dst->code = *src->code;
+    return *dst->code;
+  }
+  if (cdyar_reserveto(dst, cdyar_bulkcapacity(dst, dst->length + count)) !=
+      CDYAR_SUCCESSFUL) {
+    return *dst->code;
+  }
+
+  // open a gap in dst, fill it, then close the hole left in src
+  char *dstelements = dst->elements;
+  char *srcelements = src->elements;
+  size_t typesize = dst->typesize;
+  cdyar_relocate(dst, dstelements + (typesize * (index + count)),
+                 dstelements + (typesize * index), dst->length - index);
+  cdyar_relocate(src, dstelements + (typesize * index),
+                 srcelements + (typesize * start), count);
+  cdyar_relocate(src, srcelements + (typesize * start),
+                 srcelements + (typesize * (start + count)),
+                 src->length - start - count);
+
+  CDYAR_STAT_ADD(dst, shift_moves, dst->length - index);
+  CDYAR_STAT_ADD(dst, sets, count);
+  CDYAR_STAT_ADD(src, shift_moves, src->length - start - count);
+  cdyar_traceappend(dst, dst->length, count);
+  for (size_t i = 0; src->trace && i < count; i++) {
+    cdyar_trace_record(src->trace, CDYAR_TRACE_RM, start, 0);
+  }
+
+  dst->length += count;
+  src->length -= count;
+
+  // every position after the splice point moved, rebuild the indexes
+  if (src->index && cdyar_rebuildindex(src) != CDYAR_SUCCESSFUL) {
+    *dst->code = *src->code;
+    return *dst->code;
+  }
+  if (dst->index && cdyar_rebuildindex(dst) != CDYAR_SUCCESSFUL) {
+    return *dst->code;
+  }
+
+  *src->code = CDYAR_SUCCESSFUL;
+  *dst->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_concat(cdyar_darray *dst, cdyar_darray *src) {
+  // check dst is not null
+  if (!dst) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(dst->code);
+
+  if (cdyar_checkpair(dst, src) != CDYAR_SUCCESSFUL) {
+    return *dst->code;
+  }
+
+  // consuming an array into itself would destroy it
+  if (dst == src) {
+    *dst->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  cdyar_bool stealable =
+      dst->length == 0 &&
+      (!src->refcount || atomic_load(src->refcount) == 1) &&
+      (dst->alignment == CDYAR_DEFAULT_ALIGNMENT ||
+       src->alignment >= dst->alignment);
+
+  if (stealable) {
+    cdyar_migrate(dst, dst->pending);
+    cdyar_migrate(src, src->pending);
+
+    // swap the buffers, src gets dst's empty one and is destroyed with it
+    void *elements = dst->elements;
+    size_t capacity = dst->capacity;
+    size_t alignment = dst->alignment;
+    atomic_size_t *refcount = dst->refcount;
+    dst->elements = src->elements;
+    dst->capacity = src->capacity;
+    dst->alignment = src->alignment;
+    dst->refcount = src->refcount;
+    dst->length = src->length;
+    src->elements = elements;
+    src->capacity = capacity;
+    src->alignment = alignment;
+    src->refcount = refcount;
+    src->length = 0;
+
+    CDYAR_STAT_PEAK(dst);
+    if (dst->trace && dst->capacity != capacity) {
+      cdyar_trace_record(dst->trace, CDYAR_TRACE_RESIZE, capacity,
+                         dst->capacity);
+    }
+    cdyar_traceappend(dst, 0, dst->length);
+
+    if (dst->index && cdyar_rebuildindex(dst) != CDYAR_SUCCESSFUL) {
+      return *dst->code;
+    }
+  } else {
+    // src is about to be destroyed, an unshared buffer gives its elements
+    // up instead of having them copied and then destroyed
+    cdyar_bool owned = !src->refcount || atomic_load(src->refcount) == 1;
+    if (cdyar_appendelements(dst, src, owned) != CDYAR_SUCCESSFUL) {
+      return *dst->code;
+    }
+  }
+
+  // src is consumed either way
+  cdyar_returncode code = cdyar_darr(src);
+  *dst->code = code;
+  return code;
+}
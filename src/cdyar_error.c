@@ -8,7 +8,6 @@ const char *CDYAR_ERR_MESSAGES[CDYAR_ERR_CODE_COUNT] = {
     "memory error.\n",
     "invalid input.\n",
     "arr out of bounds.\n",
-    "invalid index range for the array's resize policy.\n",
     "values or calculations working on type size_t have overflowed.\n",
     "values or calculations working on type unsigned int have overflowed.\n",
     "dynamic array does not exist.\n",
@@ -17,7 +16,9 @@ const char *CDYAR_ERR_MESSAGES[CDYAR_ERR_CODE_COUNT] = {
     "a valid number. (NaN)\n",
     "passed a negative exponent to a function that expects positive "
     "exponenets.\n",
-    "invalid dynamic array declaration.\n"};
+    "invalid dynamic array declaration.\n",
+    "element not found.\n",
+    "i/o error.\n"};
 
 const char *cdyar_geterrmsg(cdyar_returncode *code) {
   // check that code is not null
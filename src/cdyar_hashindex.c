@@ -0,0 +1,328 @@
+#include "../headers/cdyar_hashindex.h"
+#include <stdint.h>
+#include <string.h>
+
+/** minimum number of slots of a hash index */
+#define CDYAR_HASHINDEX_MIN_SLOTS 16
+
+/*
+    internal function (type: cdyar_hashfunction)
+    default hash function, 64-bit FNV-1a followed by a final avalanche so
+   that the low bits used to pick a slot depend on every byte of the key
+*/
+static size_t cdyar_default_hash(const void *key, size_t keylength) {
+  const unsigned char *bytes = key;
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (size_t i = 0; i < keylength; i++) {
+    hash ^= bytes[i];
+    hash *= 0x100000001b3ULL;
+  }
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  return (size_t)hash;
+}
+
+/*
+    internal function
+    pointer to the key of the element at a given index
+*/
+static const void *cdyar_hashindex_key(const cdyar_darray *arr, size_t index) {
+  return ((const char *)cdyar_elementptr(arr, index)) + arr->index->keyoffset;
+}
+
+/*
+    internal function
+    place an entry into the first free slot of its probe sequence, the table
+   must have at least one free slot
+*/
+static void cdyar_hashindex_place(cdyar_hashindex *index, size_t hash,
+                                  size_t position) {
+  size_t mask = index->slotcount - 1;
+  size_t slot = hash & mask;
+  while (index->slots[slot].position != 0) {
+    slot = (slot + 1) & mask;
+  }
+  index->slots[slot].hash = hash;
+  index->slots[slot].position = position;
+  index->count++;
+}
+
+/*
+    internal function
+    rehash every entry into a table with a new number of slots
+*/
+static cdyar_returncode cdyar_hashindex_rehash(cdyar_hashindex *index,
+                                               size_t slotcount) {
+  cdyar_hashslot *slots = calloc(slotcount, sizeof(cdyar_hashslot));
+  if (!slots) {
+    return CDYAR_MEMORY_ERROR;
+  }
+
+  cdyar_hashslot *oldslots = index->slots;
+  size_t oldslotcount = index->slotcount;
+  index->slots = slots;
+  index->slotcount = slotcount;
+  index->count = 0;
+
+  // the cached hashes mean the elements don't have to be read again
+  for (size_t i = 0; i < oldslotcount; i++) {
+    if (oldslots[i].position != 0) {
+      cdyar_hashindex_place(index, oldslots[i].hash, oldslots[i].position);
+    }
+  }
+
+  free(oldslots);
+  return CDYAR_SUCCESSFUL;
+}
+
+/*
+    internal function
+    index every element of the array into an empty table sized for it
+*/
+static cdyar_returncode cdyar_hashindex_build(cdyar_darray *arr) {
+  cdyar_hashindex *index = arr->index;
+
+  // keep the load factor at or below one half after the build
+  size_t slotcount = CDYAR_HASHINDEX_MIN_SLOTS;
+  while (slotcount / 2 < arr->length) {
+    if (slotcount > SIZE_MAX / 2 / sizeof(cdyar_hashslot)) {
+      return CDYAR_SIZE_T_OVERFLOW;
+    }
+    slotcount *= 2;
+  }
+
+  cdyar_hashslot *slots = calloc(slotcount, sizeof(cdyar_hashslot));
+  if (!slots) {
+    return CDYAR_MEMORY_ERROR;
+  }
+
+  free(index->slots);
+  index->slots = slots;
+  index->slotcount = slotcount;
+  index->count = 0;
+
+  for (size_t i = 0; i < arr->length; i++) {
+    size_t hash =
+        index->hash(cdyar_hashindex_key(arr, i), index->keylength);
+    cdyar_hashindex_place(index, hash, i + 1);
+  }
+
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_attachindex(cdyar_darray *arr, const size_t keyoffset,
+                                   const size_t keylength,
+                                   const cdyar_hashfunction hash) {
+  // check arr is not null
+  if (!arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // an array carries at most one index
+  if (arr->index) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // the key must be non-empty and lie inside the element
+  if (keylength == 0 || keyoffset >= arr->typesize ||
+      keylength > arr->typesize - keyoffset) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // check that an elements array actually exists within the dynamic array
+  if (!arr->elements) {
+    *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  cdyar_hashindex *index = malloc(sizeof(cdyar_hashindex));
+  if (!index) {
+    *arr->code = CDYAR_MEMORY_ERROR;
+    return CDYAR_MEMORY_ERROR;
+  }
+
+  index->slots = NULL;
+  index->slotcount = 0;
+  index->count = 0;
+  index->keyoffset = keyoffset;
+  index->keylength = keylength;
+  index->hash = hash == CDYAR_DEFAULT_HASH ? cdyar_default_hash : hash;
+
+  arr->index = index;
+  *arr->code = cdyar_hashindex_build(arr);
+  if (*arr->code != CDYAR_SUCCESSFUL) {
+    // building failed, leave the array without an index
+    arr->index = NULL;
+    free(index->slots);
+    free(index);
+  }
+
+  return *arr->code;
+}
+
+cdyar_returncode cdyar_detachindex(cdyar_darray *arr) {
+  // check arr is not null
+  if (!arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  if (arr->index) {
+    free(arr->index->slots);
+    free(arr->index);
+    arr->index = NULL;
+  }
+
+  *arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_rebuildindex(cdyar_darray *arr) {
+  // check arr is not null
+  if (!arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // there has to be an index to rebuild
+  if (!arr->index) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // check that an elements array actually exists within the dynamic array
+  if (!arr->elements) {
+    *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  *arr->code = cdyar_hashindex_build(arr);
+  return *arr->code;
+}
+
+cdyar_returncode cdyar_lookup(const cdyar_darray *arr, const void *keyptr,
+                              size_t *outptr) {
+  // check arr is not null
+  if (!arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // check keyptr and outptr are not null, and that there is an index
+  if (!keyptr || !outptr || !arr->index) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // check that the table exists
+  cdyar_hashindex *index = arr->index;
+  if (!index->slots || !arr->elements) {
+    *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // walk the probe sequence until the key or an empty slot is found, the
+  // cached hash avoids touching elements whose keys can't match
+  size_t hash = index->hash(keyptr, index->keylength);
+  size_t mask = index->slotcount - 1;
+  for (size_t slot = hash & mask; index->slots[slot].position != 0;
+       slot = (slot + 1) & mask) {
+    if (index->slots[slot].hash != hash) {
+      continue;
+    }
+    size_t position = index->slots[slot].position - 1;
+    if (memcmp(cdyar_hashindex_key(arr, position), keyptr,
+               index->keylength) == 0) {
+      *outptr = position;
+      *arr->code = CDYAR_SUCCESSFUL;
+      return CDYAR_SUCCESSFUL;
+    }
+  }
+
+  *arr->code = CDYAR_NOT_FOUND;
+  return CDYAR_NOT_FOUND;
+}
+
+cdyar_returncode cdyar_hashindex_insert(cdyar_darray *arr,
+                                        const size_t index) {
+  cdyar_hashindex *hashindex = arr->index;
+  if (!hashindex) {
+    return CDYAR_SUCCESSFUL;
+  }
+
+  // grow once the load factor would go past three quarters. if growing
+  // fails the entry still goes in as long as a free slot is left
+  if (hashindex->count + 1 > hashindex->slotcount / 4 * 3 &&
+      hashindex->slotcount <= SIZE_MAX / 2 / sizeof(cdyar_hashslot)) {
+    cdyar_hashindex_rehash(hashindex, hashindex->slotcount * 2);
+  }
+  if (hashindex->count + 1 >= hashindex->slotcount) {
+    return CDYAR_MEMORY_ERROR;
+  }
+
+  size_t hash =
+      hashindex->hash(cdyar_hashindex_key(arr, index), hashindex->keylength);
+  cdyar_hashindex_place(hashindex, hash, index + 1);
+  return CDYAR_SUCCESSFUL;
+}
+
+void cdyar_hashindex_erase(cdyar_darray *arr, const size_t index) {
+  cdyar_hashindex *hashindex = arr->index;
+  if (!hashindex) {
+    return;
+  }
+
+  // find the slot that points at this element
+  size_t hash =
+      hashindex->hash(cdyar_hashindex_key(arr, index), hashindex->keylength);
+  size_t mask = hashindex->slotcount - 1;
+  size_t hole = hash & mask;
+  while (hashindex->slots[hole].position != index + 1) {
+    if (hashindex->slots[hole].position == 0) {
+      // the element was never indexed, nothing to erase
+      return;
+    }
+    hole = (hole + 1) & mask;
+  }
+
+  // backward shift: pull later entries of the cluster into the hole as long
+  // as that doesn't move them before their home slot
+  size_t next = (hole + 1) & mask;
+  while (hashindex->slots[next].position != 0) {
+    size_t home = hashindex->slots[next].hash & mask;
+    if (((next - home) & mask) >= ((next - hole) & mask)) {
+      hashindex->slots[hole] = hashindex->slots[next];
+      hole = next;
+    }
+    next = (next + 1) & mask;
+  }
+
+  hashindex->slots[hole].position = 0;
+  hashindex->count--;
+}
+
+void cdyar_hashindex_shift(cdyar_darray *arr, const size_t index) {
+  cdyar_hashindex *hashindex = arr->index;
+  if (!hashindex) {
+    return;
+  }
+
+  // positions are stored plus one, so everything above index + 1 moves down
+  for (size_t i = 0; i < hashindex->slotcount; i++) {
+    if (hashindex->slots[i].position > index + 1) {
+      hashindex->slots[i].position--;
+    }
+  }
+}
@@ -0,0 +1,358 @@
+#include "../headers/cdyar_heap.h"
+#include <stdint.h>
+#include <string.h>
+
+/*
+    internal function
+    pointer to the element at a given index of the heap's storage
+*/
+static void *cdyar_heap_at(const cdyar_heap *heap, size_t index) {
+  return cdyar_elementptr(heap->arr, index);
+}
+
+/*
+    internal function
+    orders two elements with the heap's comparator, or by their int64_t keys
+   when no comparator was given (keys are copied out since elements are not
+   guaranteed to be aligned for int64_t)
+*/
+static int cdyar_heap_compare(const cdyar_heap *heap, const void *left,
+                              const void *right) {
+  if (heap->cmp) {
+    return heap->cmp(left, right);
+  }
+
+  int64_t leftkey, rightkey;
+  memcpy(&leftkey, ((const char *)left) + heap->keyoffset, sizeof(int64_t));
+  memcpy(&rightkey, ((const char *)right) + heap->keyoffset, sizeof(int64_t));
+  return (leftkey > rightkey) - (leftkey < rightkey);
+}
+
+/*
+    internal function
+    moves one element between the heap's storage and its scratch space,
+   through the move hook of the array's type descriptor if the elements
+   can't be moved bitwise
+*/
+static void cdyar_heap_move(const cdyar_heap *heap, void *dst, void *src) {
+  const cdyar_typedesc *type = heap->arr->type;
+  if (type && !type->relocatable) {
+    type->move(dst, src, heap->arr->typesize);
+  } else {
+    memcpy(dst, src, heap->arr->typesize);
+  }
+}
+
+/*
+    internal function
+    moves the element at index up towards the root until its parent orders
+   before it. the element is held in scratch while its ancestors are moved
+   down, so each level costs one copy instead of a swap.
+*/
+static void cdyar_heap_siftup(cdyar_heap *heap, size_t index) {
+  cdyar_heap_move(heap, heap->scratch, cdyar_heap_at(heap, index));
+
+  while (index > 0) {
+    size_t parent = (index - 1) / heap->arity;
+    if (cdyar_heap_compare(heap, heap->scratch, cdyar_heap_at(heap, parent)) >=
+        0) {
+      break;
+    }
+    cdyar_heap_move(heap, cdyar_heap_at(heap, index),
+                    cdyar_heap_at(heap, parent));
+    index = parent;
+  }
+
+  cdyar_heap_move(heap, cdyar_heap_at(heap, index), heap->scratch);
+}
+
+/*
+    internal function
+    moves the element at index down towards the leaves until all of its
+   children order after it, using the same hole technique as siftup
+*/
+static void cdyar_heap_siftdown(cdyar_heap *heap, size_t index) {
+  size_t length = heap->arr->length;
+  if (length < 2) {
+    return;
+  }
+
+  cdyar_heap_move(heap, heap->scratch, cdyar_heap_at(heap, index));
+
+  // index has children as long as arity * index + 1 <= length - 1, written
+  // so that the multiplication cannot overflow
+  while (index <= (length - 2) / heap->arity) {
+    size_t first = heap->arity * index + 1;
+    size_t last = length - first > heap->arity ? first + heap->arity : length;
+
+    // find the smallest child
+    size_t best = first;
+    for (size_t child = first + 1; child < last; child++) {
+      if (cdyar_heap_compare(heap, cdyar_heap_at(heap, child),
+                             cdyar_heap_at(heap, best)) < 0) {
+        best = child;
+      }
+    }
+
+    if (cdyar_heap_compare(heap, cdyar_heap_at(heap, best), heap->scratch) >=
+        0) {
+      break;
+    }
+    cdyar_heap_move(heap, cdyar_heap_at(heap, index),
+                    cdyar_heap_at(heap, best));
+    index = best;
+  }
+
+  cdyar_heap_move(heap, cdyar_heap_at(heap, index), heap->scratch);
+}
+
+/*
+    internal function
+    check the parts of a heap every operation relies on, the arr pointer and
+   its code are checked by the callers before this is used
+*/
+static cdyar_returncode cdyar_heap_validate(const cdyar_heap *heap) {
+  if (!heap->scratch || !heap->arr->elements || heap->arity < 2 ||
+      heap->arr->typesize == 0) {
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_nheap(cdyar_darray *arr, const cdyar_comparator cmp,
+                             const size_t keyoffset, const size_t arity,
+                             cdyar_heap *outptr) {
+  // check arr is not null
+  if (!arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // check outptr is not null and that every node can have children
+  if (!outptr || arity < 2) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // when ordering by key, the key must lie inside the element
+  if (!cmp && (arr->typesize < sizeof(int64_t) ||
+               keyoffset > arr->typesize - sizeof(int64_t))) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // check that an elements array actually exists within the dynamic array
+  if (!arr->elements || arr->typesize == 0) {
+    *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // scratch space for one element, used while sifting
+  outptr->scratch = malloc(arr->typesize);
+  if (!outptr->scratch) {
+    *arr->code = CDYAR_MEMORY_ERROR;
+    return CDYAR_MEMORY_ERROR;
+  }
+
+  // set properties
+  outptr->arr = arr;
+  outptr->cmp = cmp;
+  outptr->keyoffset = keyoffset;
+  outptr->arity = arity;
+
+  // turn whatever the array already holds into a heap
+  return cdyar_heap_heapify(outptr);
+}
+
+cdyar_returncode cdyar_dheap(cdyar_heap *heap) {
+  // make sure heap is not null
+  if (!heap) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // free the scratch space, the array belongs to the caller
+  free(heap->scratch);
+  heap->scratch = NULL;
+  heap->arr = NULL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_heap_heapify(cdyar_heap *heap) {
+  // check heap and its storage are not null
+  if (!heap || !heap->arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(heap->arr->code);
+
+  *heap->arr->code = cdyar_heap_validate(heap);
+  if (*heap->arr->code != CDYAR_SUCCESSFUL) {
+    return *heap->arr->code;
+  }
+
+  // sifting writes into the buffer, it must not be shared with a clone
+  if (cdyar_unshare(heap->arr) != CDYAR_SUCCESSFUL) {
+    return *heap->arr->code;
+  }
+
+  // sift down every node that has children, starting from the last one
+  size_t length = heap->arr->length;
+  if (length > 1) {
+    size_t index = (length - 2) / heap->arity + 1;
+    while (index-- > 0) {
+      cdyar_heap_siftdown(heap, index);
+    }
+  }
+
+  *heap->arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_heap_push(cdyar_heap *heap, void *valueptr) {
+  // check heap and its storage are not null
+  if (!heap || !heap->arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(heap->arr->code);
+
+  *heap->arr->code = cdyar_heap_validate(heap);
+  if (*heap->arr->code != CDYAR_SUCCESSFUL) {
+    return *heap->arr->code;
+  }
+
+  // append through cdyar_set so the array's resize policy is honoured
+  cdyar_set(heap->arr, heap->arr->length, valueptr);
+  if (*heap->arr->code != CDYAR_SUCCESSFUL) {
+    // an issue occurred in cdyar_set, propagate the error upwards
+    return *heap->arr->code;
+  }
+
+  cdyar_heap_siftup(heap, heap->arr->length - 1);
+
+  *heap->arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_heap_pop(cdyar_heap *heap, void *outptr) {
+  // check heap and its storage are not null
+  if (!heap || !heap->arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(heap->arr->code);
+
+  *heap->arr->code = cdyar_heap_validate(heap);
+  if (*heap->arr->code != CDYAR_SUCCESSFUL) {
+    return *heap->arr->code;
+  }
+
+  // nothing to pop from an empty heap
+  if (heap->arr->length == 0) {
+    *heap->arr->code = CDYAR_ARR_OUT_OF_BOUNDS;
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+
+  // taking the root out writes into the buffer, it must not be shared with
+  // a clone
+  if (cdyar_unshare(heap->arr) != CDYAR_SUCCESSFUL) {
+    return *heap->arr->code;
+  }
+
+  // hand the root over to the caller if they want it, destroy it otherwise
+  void *root = cdyar_heap_at(heap, 0);
+  const cdyar_typedesc *type = heap->arr->type;
+  if (outptr && type && !type->relocatable) {
+    type->move(outptr, root, heap->arr->typesize);
+  } else if (outptr) {
+    heap->arr->handler(root, outptr, CDYAR_DIRECTION_ASSIGN_LEFT_TO_RIGHT,
+                       heap->arr->typesize, heap->arr->code);
+    if (*heap->arr->code != CDYAR_SUCCESSFUL) {
+      return *heap->arr->code;
+    }
+  } else if (type && type->destroy) {
+    type->destroy(root, heap->arr->typesize);
+  }
+
+  // move the last element into the root and let it sink into place, the
+  // slot it leaves becomes spare capacity, which is kept zeroed
+  heap->arr->length--;
+  void *last = cdyar_heap_at(heap, heap->arr->length);
+  if (heap->arr->length > 0) {
+    cdyar_heap_move(heap, root, last);
+    cdyar_heap_siftdown(heap, 0);
+  }
+  memset(last, 0, heap->arr->typesize);
+
+  *heap->arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_heap_peek(const cdyar_heap *heap, void *outptr) {
+  // check heap and its storage are not null
+  if (!heap || !heap->arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(heap->arr->code);
+
+  // nothing to peek at in an empty heap
+  if (heap->arr->length == 0) {
+    *heap->arr->code = CDYAR_ARR_OUT_OF_BOUNDS;
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+
+  // the root is the smallest element
+  return cdyar_get(heap->arr, 0, outptr);
+}
+
+cdyar_returncode cdyar_heap_decreasekey(cdyar_heap *heap, const size_t index,
+                                        void *valueptr) {
+  // check heap and its storage are not null
+  if (!heap || !heap->arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(heap->arr->code);
+
+  // check valueptr is not null
+  if (!valueptr) {
+    *heap->arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  *heap->arr->code = cdyar_heap_validate(heap);
+  if (*heap->arr->code != CDYAR_SUCCESSFUL) {
+    return *heap->arr->code;
+  }
+
+  // bounds checking
+  if (index >= heap->arr->length) {
+    *heap->arr->code = CDYAR_ARR_OUT_OF_BOUNDS;
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+
+  // a larger value would have to sink instead, which is not a decrease
+  if (cdyar_heap_compare(heap, valueptr, cdyar_heap_at(heap, index)) > 0) {
+    *heap->arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  cdyar_set(heap->arr, index, valueptr);
+  if (*heap->arr->code != CDYAR_SUCCESSFUL) {
+    // an issue occurred in cdyar_set, propagate the error upwards
+    return *heap->arr->code;
+  }
+
+  cdyar_heap_siftup(heap, index);
+
+  *heap->arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
@@ -0,0 +1,374 @@
+#if defined(__unix__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L // for read and write
+#endif
+
+#include "../headers/cdyar_io.h"
+#include "../headers/cdyar_hashindex.h"
+#include "../headers/cdyar_stats.h"
+#include "../headers/cdyar_trace.h"
+#include <string.h>
+
+#ifdef CDYAR_IO_HAS_FD
+#include <errno.h>
+#include <unistd.h>
+#endif
+
+/*
+    internal function
+    reads at most size bytes from source into buffer and returns how many
+   were read, 0 at the end of the input. sets *failed on an error
+*/
+typedef size_t (*cdyar_io_reader)(void *source, void *buffer, size_t size,
+                                  cdyar_bool *failed);
+
+/*
+    internal function
+    writes all size bytes of buffer to destination, returns cdyar_false on
+   an error
+*/
+typedef cdyar_bool (*cdyar_io_writer)(void *destination, const void *buffer,
+                                      size_t size);
+
+/*
+    internal function
+    reader for streams
+*/
+static size_t cdyar_io_readstream(void *source, void *buffer, size_t size,
+                                  cdyar_bool *failed) {
+  size_t got = fread(buffer, 1, size, (FILE *)source);
+  if (got < size && ferror((FILE *)source)) {
+    *failed = cdyar_true;
+  }
+  return got;
+}
+
+/*
+    internal function
+    writer for streams
+*/
+static cdyar_bool cdyar_io_writestream(void *destination, const void *buffer,
+                                       size_t size) {
+  return fwrite(buffer, 1, size, (FILE *)destination) == size;
+}
+
+#ifdef CDYAR_IO_HAS_FD
+
+/*
+    internal function
+    reader for file descriptors, retries reads interrupted by a signal
+*/
+static size_t cdyar_io_readfd(void *source, void *buffer, size_t size,
+                              cdyar_bool *failed) {
+  int fd = *(const int *)source;
+  for (;;) {
+    ssize_t got = read(fd, buffer, size);
+    if (got >= 0) {
+      return (size_t)got;
+    }
+    if (errno != EINTR) {
+      *failed = cdyar_true;
+      return 0;
+    }
+  }
+}
+
+/*
+    internal function
+    writer for file descriptors, continues after short writes
+*/
+static cdyar_bool cdyar_io_writefd(void *destination, const void *buffer,
+                                   size_t size) {
+  int fd = *(const int *)destination;
+  const char *next = buffer;
+  while (size > 0) {
+    ssize_t put = write(fd, next, size);
+    if (put < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return cdyar_false;
+    }
+    next += put;
+    size -= (size_t)put;
+  }
+  return cdyar_true;
+}
+
+#endif
+
+/*
+    internal function
+    makes the elements from start to arr->length known to the hash index,
+   the statistics and the trace
+*/
+static cdyar_returncode cdyar_io_commit(cdyar_darray *arr, size_t start) {
+  CDYAR_STAT_ADD(arr, sets, arr->length - start);
+
+  for (size_t i = start; arr->index && i < arr->length; i++) {
+    cdyar_returncode code = cdyar_hashindex_insert(arr, i);
+    if (code != CDYAR_SUCCESSFUL) {
+      return code;
+    }
+  }
+
+  for (size_t i = start; arr->trace && i < arr->length; i++) {
+    cdyar_trace_record(arr->trace, CDYAR_TRACE_SET, i, 0);
+  }
+
+  return CDYAR_SUCCESSFUL;
+}
+
+/*
+    internal function
+    grows a full array with its resize policy, like cdyar_set does before
+   appending
+*/
+static cdyar_returncode cdyar_io_grow(cdyar_darray *arr) {
+  *arr->code = CDYAR_SUCCESSFUL;
+  arr->policy(arr, arr->code);
+  if (*arr->code != CDYAR_SUCCESSFUL) {
+    return *arr->code;
+  }
+
+  // a policy that refuses to grow would make the read loop spin
+  if (arr->capacity == arr->length) {
+    *arr->code = CDYAR_FAILED;
+    return CDYAR_FAILED;
+  }
+
+  CDYAR_STAT_ADD(arr, resizes, 1);
+  CDYAR_STAT_ADD(arr, resize_bytes, arr->length * arr->typesize);
+  CDYAR_STAT_PEAK(arr);
+  if (arr->trace) {
+    cdyar_trace_record(arr->trace, CDYAR_TRACE_RESIZE, arr->length,
+                       arr->capacity);
+  }
+  return CDYAR_SUCCESSFUL;
+}
+
+/*
+    internal function
+    elements are read and written as raw bytes, which is only meaningful for
+   elements that own nothing and can be moved with memcpy
+*/
+static cdyar_bool cdyar_io_rawtype(const cdyar_darray *arr) {
+  return (!arr->type || (arr->type->relocatable && !arr->type->destroy))
+             ? cdyar_true
+             : cdyar_false;
+}
+
+/*
+    internal function
+    appends everything reader produces to arr. the bytes of an element cut
+   in half by a chunk boundary stay in the spare capacity right after the
+   last element until the next read completes them
+*/
+static cdyar_returncode cdyar_io_ingest(cdyar_darray *arr,
+                                        cdyar_io_reader reader, void *source,
+                                        size_t *outptr) {
+  // file bytes can't stand in for elements that own resources
+  if (!cdyar_io_rawtype(arr)) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // check that typesize is not zero
+  if (CDYAR_STRUCTURE_FAILS(arr->typesize == 0)) {
+    *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // check that an elements array actually exists within the dynamic array
+  if (CDYAR_STRUCTURE_FAILS(!arr->elements)) {
+    *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // make sure a resize policy for the dynamic array exists
+  if (CDYAR_STRUCTURE_FAILS(!arr->policy)) {
+    *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // the reads write into the buffer, it must not be shared with a clone
+  if (cdyar_unshare(arr) != CDYAR_SUCCESSFUL) {
+    return *arr->code;
+  }
+
+  size_t first = arr->length;
+  size_t partial = 0;
+  cdyar_bool failed = cdyar_false;
+  cdyar_returncode result = CDYAR_SUCCESSFUL;
+
+  for (;;) {
+    // partial is always smaller than one element, so a full array has none
+    if (arr->length == arr->capacity) {
+      result = cdyar_io_grow(arr);
+      if (result != CDYAR_SUCCESSFUL) {
+        break;
+      }
+    }
+
+    // slots past length are never part of an incremental resize, they
+    // always live in the new buffer
+    size_t room = ((arr->capacity - arr->length) * arr->typesize) - partial;
+    if (room > CDYAR_IO_CHUNK) {
+      room = CDYAR_IO_CHUNK;
+    }
+    char *next =
+        (char *)arr->elements + (arr->length * arr->typesize) + partial;
+
+    size_t got = reader(source, next, room, &failed);
+    if (got == 0) {
+      break;
+    }
+
+    // publish every element the chunk completed in one go
+    partial += got;
+    size_t start = arr->length;
+    arr->length += partial / arr->typesize;
+    partial %= arr->typesize;
+
+    result = cdyar_io_commit(arr, start);
+    if (result != CDYAR_SUCCESSFUL || failed) {
+      break;
+    }
+  }
+
+  // the stream ended inside an element, drop its bytes and keep the spare
+  // capacity zeroed
+  if (partial) {
+    memset((char *)arr->elements + (arr->length * arr->typesize), 0, partial);
+    failed = cdyar_true;
+  }
+
+  if (outptr) {
+    *outptr = arr->length - first;
+  }
+
+  if (result == CDYAR_SUCCESSFUL && failed) {
+    result = CDYAR_IO_ERROR;
+  }
+  *arr->code = result;
+  return result;
+}
+
+/*
+    internal function
+    hands the elements of arr to writer, CDYAR_IO_CHUNK bytes at a time
+*/
+static cdyar_returncode cdyar_io_writeout(cdyar_darray *arr,
+                                          cdyar_io_writer writer,
+                                          void *destination) {
+  // file bytes can't stand in for elements that own resources
+  if (!cdyar_io_rawtype(arr)) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // check that an elements array actually exists within the dynamic array
+  if (CDYAR_STRUCTURE_FAILS(!arr->elements)) {
+    *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // the elements are written out of a single buffer
+  if (cdyar_finishresize(arr) != CDYAR_SUCCESSFUL) {
+    return *arr->code;
+  }
+
+  const char *next = arr->elements;
+  size_t left = arr->length * arr->typesize;
+  while (left > 0) {
+    size_t size = left < CDYAR_IO_CHUNK ? left : CDYAR_IO_CHUNK;
+    if (!writer(destination, next, size)) {
+      *arr->code = CDYAR_IO_ERROR;
+      return CDYAR_IO_ERROR;
+    }
+    next += size;
+    left -= size;
+  }
+
+  *arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_readfile(cdyar_darray *arr, FILE *stream,
+                                size_t *outptr) {
+  // check arr is not null
+  if (CDYAR_BOUNDARY_FAILS(!arr)) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // check stream is not null
+  if (CDYAR_BOUNDARY_FAILS(!stream)) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  return cdyar_io_ingest(arr, cdyar_io_readstream, stream, outptr);
+}
+
+cdyar_returncode cdyar_writefile(cdyar_darray *arr, FILE *stream) {
+  // check arr is not null
+  if (CDYAR_BOUNDARY_FAILS(!arr)) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // check stream is not null
+  if (CDYAR_BOUNDARY_FAILS(!stream)) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  return cdyar_io_writeout(arr, cdyar_io_writestream, stream);
+}
+
+#ifdef CDYAR_IO_HAS_FD
+
+cdyar_returncode cdyar_readfd(cdyar_darray *arr, const int fd,
+                              size_t *outptr) {
+  // check arr is not null
+  if (CDYAR_BOUNDARY_FAILS(!arr)) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // check fd is a valid descriptor number
+  if (CDYAR_BOUNDARY_FAILS(fd < 0)) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  int source = fd;
+  return cdyar_io_ingest(arr, cdyar_io_readfd, &source, outptr);
+}
+
+cdyar_returncode cdyar_writefd(cdyar_darray *arr, const int fd) {
+  // check arr is not null
+  if (CDYAR_BOUNDARY_FAILS(!arr)) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // check fd is a valid descriptor number
+  if (CDYAR_BOUNDARY_FAILS(fd < 0)) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  int destination = fd;
+  return cdyar_io_writeout(arr, cdyar_io_writefd, &destination);
+}
+
+#endif
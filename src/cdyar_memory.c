@@ -0,0 +1,234 @@
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE // for madvise
+#endif
+
+#include "../headers/cdyar_memory.h"
+#include <stdint.h>
+#include <string.h>
+
+#if !defined(__STDC_NO_THREADS__)
+#include <threads.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/** page size assumed where it can't be queried */
+#define CDYAR_MEMORY_FALLBACK_PAGE 4096
+
+/** upper bound on the threads used by cdyar_memory_alloc_parallel */
+#define CDYAR_PARALLEL_MAX_THREADS 256
+
+/*
+    internal function
+    a slice of a buffer initialized by one thread
+*/
+typedef struct cdyar_memory_slice {
+  char *start;     // first byte of the slice
+  size_t size;     // bytes in the slice
+  const char *src; // bytes to copy to the start of the slice
+  size_t copysize; // bytes to copy from src, the rest is zeroed
+} cdyar_memory_slice;
+
+/*
+    internal function
+    first-touch a slice: copy its share of the source, zero the rest
+*/
+static int cdyar_memory_touch(void *arg) {
+  cdyar_memory_slice *slice = arg;
+  if (slice->copysize) {
+    memcpy(slice->start, slice->src, slice->copysize);
+  }
+  memset(slice->start + slice->copysize, 0, slice->size - slice->copysize);
+  return 0;
+}
+
+/*
+    internal function
+    number of online CPUs, 1 where it can't be queried
+*/
+static size_t cdyar_memory_cpus(void) {
+#if defined(__linux__)
+  long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  return cpus > 0 ? (size_t)cpus : 1;
+#else
+  return 1;
+#endif
+}
+
+/*
+    internal function
+    hint the kernel to use hugepages for the whole pages inside a buffer.
+   only a hint, failures are ignored
+*/
+static void cdyar_memory_hint(void *ptr, size_t size, cdyar_bool hugepages) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (!hugepages || size < CDYAR_HUGEPAGE_THRESHOLD) {
+    return;
+  }
+
+  long pagesize = sysconf(_SC_PAGESIZE);
+  if (pagesize <= 0) {
+    return;
+  }
+
+  // madvise wants a page-aligned start, skip the partial first page
+  uintptr_t start = ((uintptr_t)ptr + (uintptr_t)pagesize - 1) &
+                    ~((uintptr_t)pagesize - 1);
+  uintptr_t end = ((uintptr_t)ptr + size) & ~((uintptr_t)pagesize - 1);
+  if (end > start) {
+    madvise((void *)start, end - start, MADV_HUGEPAGE);
+  }
+#else
+  (void)ptr;
+  (void)size;
+  (void)hugepages;
+#endif
+}
+
+cdyar_bool cdyar_memory_validalignment(const size_t alignment) {
+  return (alignment & (alignment - 1)) == 0 ? cdyar_true : cdyar_false;
+}
+
+void *cdyar_memory_alloc(const size_t size, const size_t alignment,
+                         const cdyar_bool hugepages) {
+  void *ptr;
+  if (alignment == CDYAR_DEFAULT_ALIGNMENT) {
+    ptr = malloc(size);
+  } else {
+    // aligned_alloc wants the size to be a multiple of the alignment
+    if (size > SIZE_MAX - (alignment - 1)) {
+      return NULL;
+    }
+    ptr = aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+  }
+
+  if (ptr) {
+    cdyar_memory_hint(ptr, size, hugepages);
+  }
+  return ptr;
+}
+
+void *cdyar_memory_calloc(const size_t size, const size_t alignment,
+                          const cdyar_bool hugepages) {
+  // calloc can hand back fresh zero pages without touching them
+  if (alignment == CDYAR_DEFAULT_ALIGNMENT) {
+    void *ptr = calloc(1, size);
+    if (ptr) {
+      cdyar_memory_hint(ptr, size, hugepages);
+    }
+    return ptr;
+  }
+
+  void *ptr = cdyar_memory_alloc(size, alignment, hugepages);
+  if (ptr) {
+    memset(ptr, 0, size);
+  }
+  return ptr;
+}
+
+void *cdyar_memory_realloc(void *ptr, const size_t oldsize,
+                           const size_t newsize, const size_t alignment,
+                           const cdyar_bool hugepages) {
+  if (alignment == CDYAR_DEFAULT_ALIGNMENT) {
+    void *newptr = realloc(ptr, newsize);
+    if (newptr) {
+      cdyar_memory_hint(newptr, newsize, hugepages);
+    }
+    return newptr;
+  }
+
+  // realloc can't keep an alignment, move the contents by hand
+  void *newptr = cdyar_memory_alloc(newsize, alignment, hugepages);
+  if (!newptr) {
+    return NULL;
+  }
+  memcpy(newptr, ptr, oldsize < newsize ? oldsize : newsize);
+  free(ptr);
+  return newptr;
+}
+
+void *cdyar_memory_alloc_parallel(const size_t size, const size_t alignment,
+                                  const cdyar_bool hugepages, const void *src,
+                                  const size_t copysize, size_t threads) {
+  if (copysize > size || (copysize && !src)) {
+    return NULL;
+  }
+
+  char *ptr = cdyar_memory_alloc(size, alignment, hugepages);
+  if (!ptr) {
+    return NULL;
+  }
+
+  if (threads == CDYAR_PARALLEL_AUTO) {
+    threads = cdyar_memory_cpus();
+  }
+  if (threads > size / CDYAR_PARALLEL_MIN_SLICE) {
+    threads = size / CDYAR_PARALLEL_MIN_SLICE;
+  }
+  if (threads > CDYAR_PARALLEL_MAX_THREADS) {
+    threads = CDYAR_PARALLEL_MAX_THREADS;
+  }
+  if (threads < 1) {
+    threads = 1;
+  }
+
+  size_t pagesize = CDYAR_MEMORY_FALLBACK_PAGE;
+#if defined(__linux__)
+  long queried = sysconf(_SC_PAGESIZE);
+  if (queried > 0) {
+    pagesize = (size_t)queried;
+  }
+#endif
+
+  // slices end on page boundaries so every page is touched by one thread
+  cdyar_memory_slice slices[CDYAR_PARALLEL_MAX_THREADS];
+  size_t share = size / threads;
+  size_t begin = 0;
+  for (size_t i = 0; i < threads; i++) {
+    size_t end = size;
+    if (i + 1 < threads) {
+      uintptr_t boundary = ((uintptr_t)ptr + begin + share + pagesize - 1) &
+                           ~((uintptr_t)pagesize - 1);
+      end = (size_t)(boundary - (uintptr_t)ptr);
+      end = end < size ? end : size;
+    }
+    slices[i].start = ptr + begin;
+    slices[i].size = end - begin;
+    slices[i].src = src ? (const char *)src + begin : NULL;
+    slices[i].copysize =
+        copysize <= begin ? 0 : (copysize < end ? copysize : end) - begin;
+    begin = end;
+  }
+
+#if !defined(__STDC_NO_THREADS__)
+  // slice 0 is left to the calling thread, a slice whose thread couldn't be
+  // started is done here too
+  thrd_t workers[CDYAR_PARALLEL_MAX_THREADS];
+  cdyar_bool started[CDYAR_PARALLEL_MAX_THREADS] = {cdyar_false};
+  for (size_t i = 1; i < threads; i++) {
+    started[i] = thrd_create(&workers[i], cdyar_memory_touch, &slices[i]) ==
+                         thrd_success
+                     ? cdyar_true
+                     : cdyar_false;
+  }
+  for (size_t i = 0; i < threads; i++) {
+    if (!started[i]) {
+      cdyar_memory_touch(&slices[i]);
+    }
+  }
+  for (size_t i = 1; i < threads; i++) {
+    if (started[i]) {
+      thrd_join(workers[i], NULL);
+    }
+  }
+#else
+  for (size_t i = 0; i < threads; i++) {
+    cdyar_memory_touch(&slices[i]);
+  }
+#endif
+
+  return ptr;
+}
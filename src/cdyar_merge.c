@@ -0,0 +1,310 @@
+#include "../headers/cdyar_merge.h"
+#include "../headers/cdyar_hashindex.h"
+#include "../headers/cdyar_stats.h"
+#include "../headers/cdyar_trace.h"
+#include <stdint.h>
+#include <string.h>
+
+/*
+    internal function
+    state of a k-way merge: the next unread position of every source and
+   the loser tree over them. losers[0] holds the overall winner, losers[n]
+   the source that lost the match played at internal node n
+*/
+typedef struct cdyar_mergestate {
+  cdyar_darray *const *srcs;
+  size_t count;
+  cdyar_comparator cmp;
+  size_t *positions;
+  size_t *losers;
+} cdyar_mergestate;
+
+/*
+    internal function
+    whether the head of source a goes before the head of source b. exhausted
+   sources lose every match, ties go to the lower source to keep the merge
+   stable
+*/
+static cdyar_bool cdyar_merge_before(const cdyar_mergestate *state, size_t a,
+                                     size_t b) {
+  const cdyar_darray *left = state->srcs[a];
+  const cdyar_darray *right = state->srcs[b];
+  if (state->positions[a] == left->length) {
+    return cdyar_false;
+  }
+  if (state->positions[b] == right->length) {
+    return cdyar_true;
+  }
+
+  int order = state->cmp(
+      (const char *)left->elements + (left->typesize * state->positions[a]),
+      (const char *)right->elements + (right->typesize * state->positions[b]));
+  return (order < 0 || (order == 0 && a < b)) ? cdyar_true : cdyar_false;
+}
+
+/*
+    internal function
+    plays every match once, bottom-up. leaves sit at nodes count to
+   2 * count - 1, winners holds the winner of every node while the tree is
+   built
+*/
+static void cdyar_merge_build(cdyar_mergestate *state, size_t *winners) {
+  size_t count = state->count;
+  for (size_t i = 0; i < count; i++) {
+    winners[count + i] = i;
+  }
+  for (size_t node = count - 1; node > 0; node--) {
+    size_t a = winners[2 * node];
+    size_t b = winners[(2 * node) + 1];
+    if (cdyar_merge_before(state, b, a)) {
+      winners[node] = b;
+      state->losers[node] = a;
+    } else {
+      winners[node] = a;
+      state->losers[node] = b;
+    }
+  }
+  state->losers[0] = winners[1];
+}
+
+/*
+    internal function
+    the winner's head has been consumed, replay the matches on the path from
+   its leaf to the root
+*/
+static void cdyar_merge_replay(cdyar_mergestate *state) {
+  size_t winner = state->losers[0];
+  for (size_t node = (state->count + winner) / 2; node > 0; node /= 2) {
+    if (cdyar_merge_before(state, state->losers[node], winner)) {
+      size_t loser = winner;
+      winner = state->losers[node];
+      state->losers[node] = loser;
+    }
+  }
+  state->losers[0] = winner;
+}
+
+/*
+    internal function
+    check the sources of a merge and add up their lengths, reporting problems
+   in dst's code
+*/
+static cdyar_returncode cdyar_merge_checksources(cdyar_darray *dst,
+                                                 cdyar_darray *const *srcs,
+                                                 size_t count,
+                                                 size_t *outptr) {
+  size_t total = 0;
+  for (size_t i = 0; i < count; i++) {
+    cdyar_darray *src = srcs[i];
+
+    // check the source exists and is not the destination
+    if (!src || src == dst) {
+      *dst->code = CDYAR_INVALID_INPUT;
+      return CDYAR_INVALID_INPUT;
+    }
+
+    // check code is not null
+    CDYAR_CHECK_CODE(src->code);
+
+    // check that an elements array actually exists within the source
+    if (CDYAR_STRUCTURE_FAILS(!src->elements)) {
+      *dst->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+      return CDYAR_CORRUPTED_DYNAMIC_ARR;
+    }
+
+    // elements can only be merged between arrays of the same type size and
+    // type descriptor
+    if (src->typesize != dst->typesize || src->type != dst->type) {
+      *dst->code = CDYAR_INVALID_INPUT;
+      return CDYAR_INVALID_INPUT;
+    }
+
+    // check overflow
+    if (src->length > SIZE_MAX - dst->length - total) {
+      *dst->code = CDYAR_SIZE_T_OVERFLOW;
+      return CDYAR_SIZE_T_OVERFLOW;
+    }
+    total += src->length;
+  }
+
+  *outptr = total;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_merge(cdyar_darray *dst, cdyar_darray *const *srcs,
+                             const size_t count, const cdyar_comparator cmp) {
+  // check dst is not null
+  if (CDYAR_BOUNDARY_FAILS(!dst)) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(dst->code);
+
+  // check the sources and the comparator are not null
+  if (CDYAR_BOUNDARY_FAILS((!srcs && count) || !cmp)) {
+    *dst->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // check that an elements array actually exists within the dynamic array
+  if (CDYAR_STRUCTURE_FAILS(!dst->elements)) {
+    *dst->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  size_t total;
+  if (cdyar_merge_checksources(dst, srcs, count, &total) !=
+      CDYAR_SUCCESSFUL) {
+    return *dst->code;
+  }
+
+  if (total == 0) {
+    *dst->code = CDYAR_SUCCESSFUL;
+    return CDYAR_SUCCESSFUL;
+  }
+
+  // the heads are read straight out of each source's buffer
+  for (size_t i = 0; i < count; i++) {
+    cdyar_finishresize(srcs[i]);
+  }
+
+  // grow once for every merged element, this also unshares dst
+  size_t start = dst->length;
+  if (cdyar_reserve(dst, start + total) != CDYAR_SUCCESSFUL) {
+    return *dst->code;
+  }
+
+  // positions, losers and the winners used while building, in one block
+  size_t *scratch = malloc(sizeof(size_t) * 4 * count);
+  if (!scratch) {
+    *dst->code = CDYAR_MEMORY_ERROR;
+    return CDYAR_MEMORY_ERROR;
+  }
+  cdyar_mergestate state = {srcs, count, cmp, scratch, scratch + count};
+  memset(state.positions, 0, sizeof(size_t) * count);
+  cdyar_merge_build(&state, scratch + (2 * count));
+
+  cdyar_copyhook copy = dst->type ? dst->type->copy : NULL;
+  char *next = (char *)dst->elements + (dst->typesize * start);
+  cdyar_returncode result = CDYAR_SUCCESSFUL;
+  size_t merged;
+  for (merged = 0; merged < total; merged++) {
+    size_t winner = state.losers[0];
+    const cdyar_darray *src = srcs[winner];
+    const char *head =
+        (const char *)src->elements + (src->typesize * state.positions[winner]);
+
+    if (copy) {
+      copy(next, head, dst->typesize, &result);
+      if (result != CDYAR_SUCCESSFUL) {
+        break;
+      }
+    } else {
+      memcpy(next, head, dst->typesize);
+    }
+    next += dst->typesize;
+
+    state.positions[winner]++;
+    cdyar_merge_replay(&state);
+  }
+  free(scratch);
+
+  // publish what was merged, even if a copy failed half way
+  dst->length = start + merged;
+  CDYAR_STAT_ADD(dst, sets, merged);
+
+  for (size_t i = start; result == CDYAR_SUCCESSFUL && dst->index &&
+                         i < dst->length;
+       i++) {
+    result = cdyar_hashindex_insert(dst, i);
+  }
+
+  for (size_t i = start; dst->trace && i < dst->length; i++) {
+    cdyar_trace_record(dst->trace, CDYAR_TRACE_SET, i, 0);
+  }
+
+  *dst->code = result;
+  return result;
+}
+
+cdyar_returncode cdyar_unique(cdyar_darray *arr, const cdyar_comparator cmp,
+                              const cdyar_reducer reduce) {
+  // check arr is not null
+  if (CDYAR_BOUNDARY_FAILS(!arr)) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // check the comparator is not null
+  if (CDYAR_BOUNDARY_FAILS(!cmp)) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // check that an elements array actually exists within the dynamic array
+  if (CDYAR_STRUCTURE_FAILS(!arr->elements)) {
+    *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  if (arr->length < 2) {
+    *arr->code = CDYAR_SUCCESSFUL;
+    return CDYAR_SUCCESSFUL;
+  }
+
+  // duplicates are folded and moved in place, in a single buffer of our own
+  cdyar_finishresize(arr);
+  if (cdyar_unshare(arr) != CDYAR_SUCCESSFUL) {
+    return *arr->code;
+  }
+
+  size_t typesize = arr->typesize;
+  const cdyar_typedesc *type = arr->type;
+  char *elements = arr->elements;
+  char *kept = elements;
+  for (size_t i = 1; i < arr->length; i++) {
+    char *current = elements + (typesize * i);
+    if (cmp(kept, current) == 0) {
+      if (reduce) {
+        reduce(kept, current, typesize);
+      }
+      if (type && type->destroy) {
+        type->destroy(current, typesize);
+      }
+      continue;
+    }
+
+    // close the gap left by the dropped duplicates
+    kept += typesize;
+    if (kept == current) {
+      continue;
+    }
+    if (type && !type->relocatable) {
+      type->move(kept, current, typesize);
+    } else {
+      memcpy(kept, current, typesize);
+    }
+  }
+
+  // the freed slots become spare capacity, which is kept zeroed
+  size_t length = (size_t)((kept - elements) / (ptrdiff_t)typesize) + 1;
+  size_t removed = arr->length - length;
+  memset(elements + (typesize * length), 0, typesize * removed);
+  arr->length = length;
+
+  CDYAR_STAT_ADD(arr, rms, removed);
+  for (size_t i = 0; arr->trace && i < removed; i++) {
+    cdyar_trace_record(arr->trace, CDYAR_TRACE_RM, length, 0);
+  }
+
+  // every position after the first duplicate moved
+  if (removed && arr->index && cdyar_rebuildindex(arr) != CDYAR_SUCCESSFUL) {
+    return *arr->code;
+  }
+
+  *arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
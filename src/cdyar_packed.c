@@ -0,0 +1,405 @@
+#include "../headers/cdyar_packed.h"
+#include "../headers/cdyar_types.h"
+#include <string.h>
+
+/** sign bit of a 64-bit value, flipped to order signed values as unsigned */
+#define CDYAR_PACKED_SIGN ((uint64_t)1 << 63)
+
+/*
+    internal function
+    read element index of a dynamic array as an unsigned 64-bit value that
+   orders the same way as the element
+*/
+static uint64_t cdyar_packed_load(const cdyar_darray *arr, size_t index,
+                                  cdyar_bool issigned) {
+  const void *element = cdyar_elementptr(arr, index);
+  if (arr->typesize == sizeof(uint32_t)) {
+    uint32_t value;
+    memcpy(&value, element, sizeof(value));
+    if (issigned) {
+      return (uint64_t)(int64_t)(int32_t)value ^ CDYAR_PACKED_SIGN;
+    }
+    return value;
+  }
+
+  uint64_t value;
+  memcpy(&value, element, sizeof(value));
+  return issigned ? value ^ CDYAR_PACKED_SIGN : value;
+}
+
+/*
+    internal function
+    inverse of cdyar_packed_load, store a decoded value as an element
+*/
+static void cdyar_packed_store(const cdyar_packed *packed, uint64_t value,
+                               void *outptr) {
+  if (packed->issigned) {
+    value ^= CDYAR_PACKED_SIGN;
+  }
+  if (packed->typesize == sizeof(uint32_t)) {
+    uint32_t narrow = (uint32_t)value;
+    memcpy(outptr, &narrow, sizeof(narrow));
+  } else {
+    memcpy(outptr, &value, sizeof(value));
+  }
+}
+
+/*
+    internal function
+    number of bits needed to represent value
+*/
+static unsigned char cdyar_packed_width(uint64_t value) {
+  unsigned char width = 0;
+  while (value) {
+    width++;
+    value >>= 1;
+  }
+  return width;
+}
+
+/*
+    internal function
+    number of words holding count values of width bits
+*/
+static size_t cdyar_packed_words(size_t count, unsigned char width) {
+  return ((count * width) + 63) / 64;
+}
+
+/*
+    internal function
+    pick the encoding of the count elements of a block starting at first.
+   fills base, width and encoding, offset is left to the caller
+*/
+static void cdyar_packed_plan(const cdyar_darray *arr, cdyar_bool issigned,
+                              size_t first, size_t count,
+                              cdyar_packedblock *block) {
+  uint64_t min = cdyar_packed_load(arr, first, issigned);
+  uint64_t max = min;
+  uint64_t maxdelta = 0;
+  cdyar_bool ascending = cdyar_true;
+
+  uint64_t previous = min;
+  for (size_t i = 1; i < count; i++) {
+    uint64_t value = cdyar_packed_load(arr, first + i, issigned);
+    min = value < min ? value : min;
+    max = value > max ? value : max;
+    if (value < previous) {
+      ascending = cdyar_false;
+    } else if (value - previous > maxdelta) {
+      maxdelta = value - previous;
+    }
+    previous = value;
+  }
+
+  // frame of reference always works, delta only pays off on sorted runs
+  // whose steps are narrower than their spread
+  unsigned char forwidth = cdyar_packed_width(max - min);
+  unsigned char deltawidth = cdyar_packed_width(maxdelta);
+  if (ascending && deltawidth < forwidth) {
+    block->base = cdyar_packed_load(arr, first, issigned);
+    block->width = deltawidth;
+    block->encoding = CDYAR_PACKED_DELTA;
+  } else {
+    block->base = min;
+    block->width = forwidth;
+    block->encoding = CDYAR_PACKED_FOR;
+  }
+}
+
+/*
+    internal function
+    write value as the index-th value of width bits starting at words
+*/
+static void cdyar_packed_put(uint64_t *words, size_t index,
+                             unsigned char width, uint64_t value) {
+  if (width == 0) {
+    return;
+  }
+  size_t bit = index * width;
+  size_t word = bit / 64;
+  unsigned shift = (unsigned)(bit % 64);
+  words[word] |= value << shift;
+  if (shift + width > 64) {
+    words[word + 1] |= value >> (64 - shift);
+  }
+}
+
+/*
+    internal function
+    read the index-th value of width bits starting at words
+*/
+static uint64_t cdyar_packed_take(const uint64_t *words, size_t index,
+                                  unsigned char width) {
+  if (width == 0) {
+    return 0;
+  }
+  size_t bit = index * width;
+  size_t word = bit / 64;
+  unsigned shift = (unsigned)(bit % 64);
+  uint64_t value = words[word] >> shift;
+  if (shift + width > 64) {
+    value |= words[word + 1] << (64 - shift);
+  }
+  return width == 64 ? value : value & (((uint64_t)1 << width) - 1);
+}
+
+/*
+    internal function
+    decode element index of a packed array
+*/
+static uint64_t cdyar_packed_decode(const cdyar_packed *packed, size_t index) {
+  const cdyar_packedblock *block =
+      &packed->blocks[index / CDYAR_PACKED_BLOCK_SIZE];
+  const uint64_t *words = packed->data + block->offset;
+  size_t position = index % CDYAR_PACKED_BLOCK_SIZE;
+
+  if (block->encoding == CDYAR_PACKED_FOR) {
+    return block->base + cdyar_packed_take(words, position, block->width);
+  }
+
+  // the first delta of a block is always zero, skip it
+  uint64_t value = block->base;
+  for (size_t i = 1; i <= position; i++) {
+    value += cdyar_packed_take(words, i, block->width);
+  }
+  return value;
+}
+
+cdyar_returncode cdyar_npacked(const cdyar_darray *arr,
+                               const cdyar_bool issigned,
+                               cdyar_packed *outptr) {
+  // check arr is not null
+  if (!arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // check outptr is not null
+  if (!outptr) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // only 32- and 64-bit integers can be packed
+  if (arr->typesize != sizeof(uint32_t) && arr->typesize != sizeof(uint64_t)) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // check that an elements array actually exists within the dynamic array
+  if (!arr->elements) {
+    *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // create a cdyar_returncode for the packed array
+  cdyar_returncode *code = malloc(sizeof(cdyar_returncode));
+  if (!code) {
+    *arr->code = CDYAR_MEMORY_ERROR;
+    return CDYAR_MEMORY_ERROR;
+  }
+  *code = CDYAR_SUCCESSFUL;
+
+  // first pass, pick every block's encoding and find where it starts
+  size_t blockcount = (arr->length + CDYAR_PACKED_BLOCK_SIZE - 1) /
+                      CDYAR_PACKED_BLOCK_SIZE;
+  cdyar_packedblock *blocks =
+      calloc(blockcount ? blockcount : 1, sizeof(cdyar_packedblock));
+  if (!blocks) {
+    free(code);
+    *arr->code = CDYAR_MEMORY_ERROR;
+    return CDYAR_MEMORY_ERROR;
+  }
+
+  size_t words = 0;
+  for (size_t b = 0; b < blockcount; b++) {
+    size_t first = b * CDYAR_PACKED_BLOCK_SIZE;
+    size_t count = arr->length - first < CDYAR_PACKED_BLOCK_SIZE
+                       ? arr->length - first
+                       : CDYAR_PACKED_BLOCK_SIZE;
+    cdyar_packed_plan(arr, issigned, first, count, &blocks[b]);
+    blocks[b].offset = words;
+    words += cdyar_packed_words(count, blocks[b].width);
+  }
+
+  // second pass, pack the values
+  uint64_t *data = calloc(words ? words : 1, sizeof(uint64_t));
+  if (!data) {
+    free(blocks);
+    free(code);
+    *arr->code = CDYAR_MEMORY_ERROR;
+    return CDYAR_MEMORY_ERROR;
+  }
+
+  for (size_t b = 0; b < blockcount; b++) {
+    size_t first = b * CDYAR_PACKED_BLOCK_SIZE;
+    size_t count = arr->length - first < CDYAR_PACKED_BLOCK_SIZE
+                       ? arr->length - first
+                       : CDYAR_PACKED_BLOCK_SIZE;
+    uint64_t previous = blocks[b].base;
+    for (size_t i = 0; i < count; i++) {
+      uint64_t value = cdyar_packed_load(arr, first + i, issigned);
+      uint64_t stored = blocks[b].encoding == CDYAR_PACKED_DELTA
+                            ? value - previous
+                            : value - blocks[b].base;
+      cdyar_packed_put(data + blocks[b].offset, i, blocks[b].width, stored);
+      previous = value;
+    }
+  }
+
+  // set properties, indicate success
+  outptr->data = data;
+  outptr->words = words;
+  outptr->blocks = blocks;
+  outptr->length = arr->length;
+  outptr->typesize = arr->typesize;
+  outptr->issigned = issigned ? cdyar_true : cdyar_false;
+  outptr->code = code;
+
+  *arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_dpacked(cdyar_packed *packed) {
+  // make sure packed is not null
+  if (!packed) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  CDYAR_CHECK_CODE(packed->code);
+
+  // if the data and block index exist, free them
+  if (packed->data && packed->blocks) {
+    free(packed->data);
+    free(packed->blocks);
+  } else {
+    *packed->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+  packed->data = NULL;
+  packed->blocks = NULL;
+  packed->words = 0;
+  packed->length = 0;
+
+  // free code
+  cdyar_returncode tempcode = *packed->code;
+  free(packed->code);
+  packed->code = NULL;
+
+  return tempcode;
+}
+
+cdyar_returncode cdyar_packed_get(const cdyar_packed *packed,
+                                  const size_t index, void *outptr) {
+  // check packed is not null
+  if (!packed) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(packed->code);
+
+  // check outptr is not null
+  if (!outptr) {
+    *packed->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // check that the data and block index exist
+  if (!packed->data || !packed->blocks) {
+    *packed->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // bounds checking
+  if (index >= packed->length) {
+    *packed->code = CDYAR_ARR_OUT_OF_BOUNDS;
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+
+  cdyar_packed_store(packed, cdyar_packed_decode(packed, index), outptr);
+  *packed->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_packed_unpack(const cdyar_packed *packed,
+                                     const cdyar_resizepolicy policy,
+                                     const cdyar_flag flags,
+                                     cdyar_darray *outptr) {
+  // check packed is not null
+  if (!packed) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(packed->code);
+
+  // check outptr is not null
+  if (!outptr) {
+    *packed->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // check that the data and block index exist
+  if (!packed->data || !packed->blocks) {
+    *packed->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  *packed->code =
+      cdyar_narr(packed->typesize, packed->length ? packed->length : 1, policy,
+                 cdyar_generic_typehandler, flags, outptr);
+  if (*packed->code != CDYAR_SUCCESSFUL) {
+    return *packed->code;
+  }
+
+  // decode block by block, delta blocks carry their running sum along
+  char *elements = outptr->elements;
+  for (size_t first = 0; first < packed->length;
+       first += CDYAR_PACKED_BLOCK_SIZE) {
+    const cdyar_packedblock *block =
+        &packed->blocks[first / CDYAR_PACKED_BLOCK_SIZE];
+    const uint64_t *words = packed->data + block->offset;
+    size_t count = packed->length - first < CDYAR_PACKED_BLOCK_SIZE
+                       ? packed->length - first
+                       : CDYAR_PACKED_BLOCK_SIZE;
+    uint64_t value = block->base;
+    for (size_t i = 0; i < count; i++) {
+      uint64_t stored = cdyar_packed_take(words, i, block->width);
+      value = block->encoding == CDYAR_PACKED_DELTA ? value + stored
+                                                    : block->base + stored;
+      cdyar_packed_store(packed, value,
+                         elements + (packed->typesize * (first + i)));
+    }
+  }
+  outptr->length = packed->length;
+
+  *packed->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_packed_bytes(const cdyar_packed *packed,
+                                    size_t *outptr) {
+  // check packed is not null
+  if (!packed) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(packed->code);
+
+  // check outptr is not null
+  if (!outptr) {
+    *packed->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  size_t blockcount = (packed->length + CDYAR_PACKED_BLOCK_SIZE - 1) /
+                      CDYAR_PACKED_BLOCK_SIZE;
+  *outptr = (packed->words * sizeof(uint64_t)) +
+            (blockcount * sizeof(cdyar_packedblock));
+
+  *packed->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
@@ -0,0 +1,373 @@
+#include "../headers/cdyar_ring.h"
+#include "../headers/cdyar_arithmetic.h"
+#include <stdint.h>
+#include <string.h>
+
+/*
+    internal function
+    translate a logical index (counted from the head) into a pointer to its
+   physical slot, index must be smaller than the capacity
+*/
+static void *cdyar_ring_slot(const cdyar_ring *ring, size_t index) {
+  // written so that head + index is never computed when it could overflow
+  size_t slot = index < ring->capacity - ring->head
+                    ? ring->head + index
+                    : index - (ring->capacity - ring->head);
+  return ((char *)ring->elements) + (ring->typesize * slot);
+}
+
+/*
+    internal function
+    check the parts of a ring every operation relies on
+*/
+static cdyar_returncode cdyar_ring_validate(const cdyar_ring *ring) {
+  // check that an elements array exists and there is a handler
+  if (!ring->elements || !ring->handler) {
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // check that the bookkeeping is consistent
+  if (ring->typesize == 0 || ring->head >= ring->capacity ||
+      ring->length > ring->capacity) {
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  return CDYAR_SUCCESSFUL;
+}
+
+/*
+    internal function
+    doubles the capacity of a full ring. the elements are unwrapped into the
+   new buffer, so the first element ends up in slot 0 and head is reset.
+
+    args: 1) cdyar_ring* ring      : a pointer to the ring
+          2) cdyar_returncode* code: a pointer to a returncode variable to
+   store status returns: void
+*/
+static void cdyar_ring_grow(cdyar_ring *ring, cdyar_returncode *code) {
+  // check code is not null
+  CDYAR_CHECK_CODE(code);
+
+  // check overflow
+  size_t doubled, bytes;
+  if (cdyar_mul_overflows(ring->capacity, 2, &doubled) ||
+      cdyar_mul_overflows(doubled, ring->typesize, &bytes)) {
+    *code = CDYAR_SIZE_T_OVERFLOW;
+    return;
+  }
+
+  void *elements_temp = malloc(bytes);
+  if (!elements_temp) {
+    *code = CDYAR_MEMORY_ERROR;
+    return;
+  }
+
+  // copy the part from head to the end of the buffer, then the part that
+  // wrapped around to the start of the buffer
+  size_t first = ring->capacity - ring->head;
+  if (first > ring->length) {
+    first = ring->length;
+  }
+  memcpy(elements_temp,
+         ((char *)ring->elements) + (ring->typesize * ring->head),
+         ring->typesize * first);
+  memcpy(((char *)elements_temp) + (ring->typesize * first), ring->elements,
+         ring->typesize * (ring->length - first));
+
+  free(ring->elements);
+  ring->elements = elements_temp;
+  ring->head = 0;
+  ring->capacity = doubled;
+  *code = CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_nring(const size_t typesize, const size_t capacity,
+                             const cdyar_typehandler handler,
+                             cdyar_ring *outptr) {
+  // make sure outptr is not null
+  if (!outptr) {
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // make sure capacity and typesize are positive and handler is not null
+  if (capacity == 0 || typesize == 0 || !handler) {
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // make sure there is no overflow
+  if (capacity > SIZE_MAX / typesize) {
+    return CDYAR_SIZE_T_OVERFLOW;
+  }
+
+  // create a cdyar_returncode for the ring
+  cdyar_returncode *code = malloc(sizeof(cdyar_returncode));
+  if (!code) {
+    return CDYAR_MEMORY_ERROR;
+  }
+  *code = CDYAR_SUCCESSFUL;
+
+  // allocate memory for the circular buffer
+  outptr->elements = malloc(capacity * typesize);
+  if (!outptr->elements) {
+    free(code);
+    return CDYAR_MEMORY_ERROR;
+  }
+
+  // set properties, indicate success
+  outptr->head = 0;
+  outptr->length = 0;
+  outptr->capacity = capacity;
+  outptr->typesize = typesize;
+  outptr->handler = handler;
+  outptr->code = code;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_dring(cdyar_ring *ring) {
+  // make sure ring is not null
+  if (!ring) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  CDYAR_CHECK_CODE(ring->code);
+
+  // if the circular buffer exists, free it
+  if (ring->elements) {
+    free(ring->elements);
+    ring->elements = NULL;
+  } else {
+    *ring->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // free code
+  cdyar_returncode tempcode = *ring->code;
+  free(ring->code);
+  ring->code = NULL;
+
+  return tempcode;
+}
+
+cdyar_returncode cdyar_ring_pushback(cdyar_ring *ring, void *valueptr) {
+  // check that ring is not null
+  if (!ring) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check that code is not null
+  CDYAR_CHECK_CODE(ring->code);
+
+  // check that valueptr is not null
+  if (!valueptr) {
+    *ring->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  *ring->code = cdyar_ring_validate(ring);
+  if (*ring->code != CDYAR_SUCCESSFUL) {
+    return *ring->code;
+  }
+
+  // make sure there is room for one more element
+  if (ring->length == ring->capacity) {
+    cdyar_ring_grow(ring, ring->code);
+    if (*ring->code != CDYAR_SUCCESSFUL) {
+      return *ring->code;
+    }
+  }
+
+  // the slot right after the last element
+  ring->handler(cdyar_ring_slot(ring, ring->length), valueptr,
+                CDYAR_DIRECTION_ASSIGN_RIGHT_TO_LEFT, ring->typesize,
+                ring->code);
+  if (*ring->code == CDYAR_SUCCESSFUL) {
+    ring->length += 1;
+  }
+
+  return *ring->code;
+}
+
+cdyar_returncode cdyar_ring_pushfront(cdyar_ring *ring, void *valueptr) {
+  // check that ring is not null
+  if (!ring) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check that code is not null
+  CDYAR_CHECK_CODE(ring->code);
+
+  // check that valueptr is not null
+  if (!valueptr) {
+    *ring->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  *ring->code = cdyar_ring_validate(ring);
+  if (*ring->code != CDYAR_SUCCESSFUL) {
+    return *ring->code;
+  }
+
+  // make sure there is room for one more element
+  if (ring->length == ring->capacity) {
+    cdyar_ring_grow(ring, ring->code);
+    if (*ring->code != CDYAR_SUCCESSFUL) {
+      return *ring->code;
+    }
+  }
+
+  // the slot right before the head, wrapping around to the end of the buffer
+  size_t newhead = ring->head == 0 ? ring->capacity - 1 : ring->head - 1;
+  ring->handler(((char *)ring->elements) + (ring->typesize * newhead),
+                valueptr, CDYAR_DIRECTION_ASSIGN_RIGHT_TO_LEFT, ring->typesize,
+                ring->code);
+  if (*ring->code == CDYAR_SUCCESSFUL) {
+    ring->head = newhead;
+    ring->length += 1;
+  }
+
+  return *ring->code;
+}
+
+cdyar_returncode cdyar_ring_popfront(cdyar_ring *ring, void *outptr) {
+  // check that ring is not null
+  if (!ring) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check that code is not null
+  CDYAR_CHECK_CODE(ring->code);
+
+  *ring->code = cdyar_ring_validate(ring);
+  if (*ring->code != CDYAR_SUCCESSFUL) {
+    return *ring->code;
+  }
+
+  // nothing to pop from an empty ring
+  if (ring->length == 0) {
+    *ring->code = CDYAR_ARR_OUT_OF_BOUNDS;
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+
+  // copy the element out if the caller wants it
+  if (outptr) {
+    ring->handler(cdyar_ring_slot(ring, 0), outptr,
+                  CDYAR_DIRECTION_ASSIGN_LEFT_TO_RIGHT, ring->typesize,
+                  ring->code);
+    if (*ring->code != CDYAR_SUCCESSFUL) {
+      return *ring->code;
+    }
+  }
+
+  // advance the head past the removed element
+  ring->head = ring->head == ring->capacity - 1 ? 0 : ring->head + 1;
+  ring->length -= 1;
+
+  *ring->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_ring_popback(cdyar_ring *ring, void *outptr) {
+  // check that ring is not null
+  if (!ring) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check that code is not null
+  CDYAR_CHECK_CODE(ring->code);
+
+  *ring->code = cdyar_ring_validate(ring);
+  if (*ring->code != CDYAR_SUCCESSFUL) {
+    return *ring->code;
+  }
+
+  // nothing to pop from an empty ring
+  if (ring->length == 0) {
+    *ring->code = CDYAR_ARR_OUT_OF_BOUNDS;
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+
+  // copy the element out if the caller wants it
+  if (outptr) {
+    ring->handler(cdyar_ring_slot(ring, ring->length - 1), outptr,
+                  CDYAR_DIRECTION_ASSIGN_LEFT_TO_RIGHT, ring->typesize,
+                  ring->code);
+    if (*ring->code != CDYAR_SUCCESSFUL) {
+      return *ring->code;
+    }
+  }
+
+  ring->length -= 1;
+
+  *ring->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_ring_set(cdyar_ring *ring, const size_t index,
+                                void *valueptr) {
+  // check that ring is not null
+  if (!ring) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check that code is not null
+  CDYAR_CHECK_CODE(ring->code);
+
+  // setting right after the last element is an append
+  if (index == ring->length) {
+    return cdyar_ring_pushback(ring, valueptr);
+  }
+
+  // check that valueptr is not null
+  if (!valueptr) {
+    *ring->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  *ring->code = cdyar_ring_validate(ring);
+  if (*ring->code != CDYAR_SUCCESSFUL) {
+    return *ring->code;
+  }
+
+  // bounds checking
+  if (index > ring->length) {
+    *ring->code = CDYAR_ARR_OUT_OF_BOUNDS;
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+
+  ring->handler(cdyar_ring_slot(ring, index), valueptr,
+                CDYAR_DIRECTION_ASSIGN_RIGHT_TO_LEFT, ring->typesize,
+                ring->code);
+  return *ring->code;
+}
+
+cdyar_returncode cdyar_ring_get(const cdyar_ring *ring, const size_t index,
+                                void *outptr) {
+  // check ring is not null
+  if (!ring) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(ring->code);
+
+  // check outptr is not null
+  if (!outptr) {
+    *ring->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  *ring->code = cdyar_ring_validate(ring);
+  if (*ring->code != CDYAR_SUCCESSFUL) {
+    return *ring->code;
+  }
+
+  // bounds checking
+  if (index >= ring->length) {
+    *ring->code = CDYAR_ARR_OUT_OF_BOUNDS;
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+
+  ring->handler(cdyar_ring_slot(ring, index), outptr,
+                CDYAR_DIRECTION_ASSIGN_LEFT_TO_RIGHT, ring->typesize,
+                ring->code);
+  return *ring->code;
+}
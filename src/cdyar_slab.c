@@ -0,0 +1,122 @@
+#include "../headers/cdyar_slab.h"
+#include <stdint.h>
+
+/*
+    internal function
+    allocate a new chunk and thread all of its slots onto the free list
+*/
+static cdyar_returncode cdyar_slab_grow(cdyar_slab *slab) {
+  // make sure the chunk's size doesn't overflow
+  if (slab->chunksize >
+      (SIZE_MAX - sizeof(cdyar_slabchunk)) / sizeof(cdyar_slabnode)) {
+    return CDYAR_SIZE_T_OVERFLOW;
+  }
+
+  cdyar_slabchunk *chunk = malloc(sizeof(cdyar_slabchunk) +
+                                  slab->chunksize * sizeof(cdyar_slabnode));
+  if (!chunk) {
+    return CDYAR_MEMORY_ERROR;
+  }
+
+  // link the slots in order so that headers are handed out front to back
+  for (size_t i = 0; i + 1 < slab->chunksize; i++) {
+    chunk->nodes[i].next = &chunk->nodes[i + 1];
+  }
+  chunk->nodes[slab->chunksize - 1].next = slab->freelist;
+  slab->freelist = &chunk->nodes[0];
+
+  chunk->next = slab->chunks;
+  slab->chunks = chunk;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_nslab(const size_t chunksize, cdyar_slab *outptr) {
+  // make sure outptr is not null and chunks hold at least one slot
+  if (!outptr || chunksize == 0) {
+    return CDYAR_INVALID_INPUT;
+  }
+
+  outptr->chunks = NULL;
+  outptr->freelist = NULL;
+  outptr->chunksize = chunksize;
+  outptr->live = 0;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_dslab(cdyar_slab *slab) {
+  // make sure slab is not null
+  if (!slab) {
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // freeing the chunks would pull the headers from under live arrays
+  if (slab->live != 0) {
+    return CDYAR_INVALID_INPUT;
+  }
+
+  cdyar_slabchunk *chunk = slab->chunks;
+  while (chunk) {
+    cdyar_slabchunk *next = chunk->next;
+    free(chunk);
+    chunk = next;
+  }
+
+  slab->chunks = NULL;
+  slab->freelist = NULL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_slab_narr(cdyar_slab *slab, const size_t typesize,
+                                 const size_t capacity,
+                                 const cdyar_resizepolicy policy,
+                                 const cdyar_typehandler handler,
+                                 const cdyar_flag flags,
+                                 cdyar_darray **outptr) {
+  // make sure slab and outptr are not null
+  if (!slab || !outptr) {
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // take a header from the free list, allocating a new chunk if it is empty
+  if (!slab->freelist) {
+    cdyar_returncode code = cdyar_slab_grow(slab);
+    if (code != CDYAR_SUCCESSFUL) {
+      return code;
+    }
+  }
+  cdyar_slabnode *node = slab->freelist;
+  slab->freelist = node->next;
+
+  // the header already carries room for the return code, use it
+  cdyar_returncode code = cdyar_narr(typesize, capacity, policy, handler,
+                                     flags | CDYAR_ARR_INLINE_CODE, &node->arr);
+  if (code != CDYAR_SUCCESSFUL) {
+    // give the slot back to the free list
+    node->next = slab->freelist;
+    slab->freelist = node;
+    return code;
+  }
+
+  slab->live++;
+  *outptr = &node->arr;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_slab_darr(cdyar_slab *slab, cdyar_darray *arr) {
+  // make sure slab and arr are not null
+  if (!slab) {
+    return CDYAR_INVALID_INPUT;
+  }
+  if (!arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // free the array's data, then put its header back on the free list
+  cdyar_returncode code = cdyar_darr(arr);
+
+  cdyar_slabnode *node = (cdyar_slabnode *)arr;
+  node->next = slab->freelist;
+  slab->freelist = node;
+  slab->live--;
+  return code;
+}
@@ -0,0 +1,355 @@
+#include "../headers/cdyar_soa.h"
+#include "../headers/cdyar_arithmetic.h"
+#include <stdint.h>
+#include <string.h>
+
+/*
+    internal function (type: cdyar_soa_resizepolicy)
+    default resize policy for structure-of-arrays containers. It doubles the
+   capacity of every column, zeroing the new portion of each one.
+
+    args: 1) cdyar_soa* soa        : a pointer to the container
+          2) cdyar_returncode* code: a pointer to a returncode variable to
+   store status returns: void
+*/
+static void cdyar_soa_default_resize_policy(cdyar_soa *soa,
+                                            cdyar_returncode *code) {
+  // check code is not null
+  CDYAR_CHECK_CODE(code);
+
+  // check soa is not null
+  if (!soa) {
+    *code = CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+    return;
+  }
+
+  // check that the columns exist
+  if (!soa->columns || !soa->fields) {
+    *code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return;
+  }
+
+  // make sure that length is actually equal to capacity
+  if (soa->length != soa->capacity) {
+    *code = CDYAR_INVALID_INPUT;
+    return;
+  }
+
+  // grow the columns one by one. if one of them fails, the columns that were
+  // already grown are simply bigger than needed, capacity stays untouched
+  for (size_t i = 0; i < soa->fieldcount; i++) {
+    size_t fieldsize = soa->fields[i].size;
+
+    size_t doubled, bytes;
+    if (cdyar_mul_overflows(soa->capacity, 2, &doubled) ||
+        cdyar_mul_overflows(doubled, fieldsize, &bytes)) {
+      *code = CDYAR_SIZE_T_OVERFLOW;
+      return;
+    }
+
+    void *column_temp =
+        realloc(soa->columns[i], soa->capacity * fieldsize * 2);
+    if (!column_temp) {
+      *code = CDYAR_MEMORY_ERROR;
+      return;
+    }
+
+    // zero out the new portion of the column
+    soa->columns[i] = column_temp;
+    memset(((char *)soa->columns[i]) + (fieldsize * soa->capacity), 0,
+           fieldsize * soa->capacity);
+  }
+
+  // make sure to double the capacity
+  soa->capacity *= 2;
+  *code = CDYAR_SUCCESSFUL;
+}
+
+/*
+    internal function
+    frees every column that has been allocated so far along with the
+   bookkeeping arrays of a container, used on destruction and on failed
+   creation
+*/
+static void cdyar_soa_freecolumns(cdyar_soa *soa, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    free(soa->columns[i]);
+  }
+  free(soa->columns);
+  free(soa->fields);
+  soa->columns = NULL;
+  soa->fields = NULL;
+}
+
+cdyar_returncode cdyar_nsoa(const cdyar_soa_field *fields,
+                            const size_t fieldcount, const size_t recordsize,
+                            const size_t capacity,
+                            const cdyar_soa_resizepolicy policy,
+                            cdyar_soa *outptr) {
+  // make sure outptr and the layout are not null
+  if (!outptr || !fields) {
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // make sure there is at least one field, a record size and a capacity
+  if (fieldcount == 0 || recordsize == 0 || capacity == 0) {
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // make sure every field lies inside the record
+  for (size_t i = 0; i < fieldcount; i++) {
+    if (fields[i].size == 0 || fields[i].offset >= recordsize ||
+        fields[i].size > recordsize - fields[i].offset) {
+      return CDYAR_INVALID_INPUT;
+    }
+
+    // make sure there is no overflow
+    if (capacity > SIZE_MAX / fields[i].size) {
+      return CDYAR_SIZE_T_OVERFLOW;
+    }
+  }
+
+  // make sure the bookkeeping arrays don't overflow either
+  if (fieldcount > SIZE_MAX / sizeof(cdyar_soa_field)) {
+    return CDYAR_SIZE_T_OVERFLOW;
+  }
+
+  // create a cdyar_returncode for the container
+  cdyar_returncode *code = malloc(sizeof(cdyar_returncode));
+  if (!code) {
+    return CDYAR_MEMORY_ERROR;
+  }
+  *code = CDYAR_SUCCESSFUL;
+
+  // keep a private copy of the layout
+  outptr->fields = malloc(fieldcount * sizeof(cdyar_soa_field));
+  outptr->columns = calloc(fieldcount, sizeof(void *));
+  if (!outptr->fields || !outptr->columns) {
+    cdyar_soa_freecolumns(outptr, 0);
+    free(code);
+    return CDYAR_MEMORY_ERROR;
+  }
+  memcpy(outptr->fields, fields, fieldcount * sizeof(cdyar_soa_field));
+
+  // allocate (zeroed) memory for every column
+  for (size_t i = 0; i < fieldcount; i++) {
+    outptr->columns[i] = calloc(capacity, fields[i].size);
+    if (!outptr->columns[i]) {
+      cdyar_soa_freecolumns(outptr, i);
+      free(code);
+      return CDYAR_MEMORY_ERROR;
+    }
+  }
+
+  // set properties
+  outptr->fieldcount = fieldcount;
+  outptr->recordsize = recordsize;
+  outptr->length = 0;
+  outptr->capacity = capacity;
+  outptr->code = code;
+
+  // assign resize policy, indicate success
+  if (policy == CDYAR_SOA_DEFAULT_RESIZE_POLICY) {
+    outptr->policy = cdyar_soa_default_resize_policy;
+  } else {
+    outptr->policy = policy;
+  }
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_dsoa(cdyar_soa *soa) {
+  // make sure soa is not null
+  if (!soa) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  CDYAR_CHECK_CODE(soa->code);
+
+  // free the columns if they exist
+  if (soa->columns && soa->fields) {
+    cdyar_soa_freecolumns(soa, soa->fieldcount);
+  } else {
+    *soa->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // free code
+  cdyar_returncode tempcode = *soa->code;
+  free(soa->code);
+  soa->code = NULL;
+
+  return tempcode;
+}
+
+cdyar_returncode cdyar_soa_set(cdyar_soa *soa, const size_t index,
+                               const void *recordptr) {
+  // check that soa is not null
+  if (!soa) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check that code is not null
+  CDYAR_CHECK_CODE(soa->code);
+
+  // check that recordptr is not null
+  if (!recordptr) {
+    *soa->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // check that the columns exist and that there is a resize policy
+  if (!soa->columns || !soa->fields || !soa->policy) {
+    *soa->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // same rules as cdyar_set: replace an existing record or append one
+  if (index > soa->length) {
+    *soa->code = CDYAR_ARR_OUT_OF_BOUNDS;
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+
+  if (index == soa->length && soa->length == soa->capacity) {
+    // every column is full, grow all of them together
+    soa->policy(soa, soa->code);
+    if (*soa->code != CDYAR_SUCCESSFUL) {
+      return *soa->code;
+    }
+  }
+
+  // scatter the fields of the record into their columns
+  for (size_t i = 0; i < soa->fieldcount; i++) {
+    size_t fieldsize = soa->fields[i].size;
+    memcpy(((char *)soa->columns[i]) + (fieldsize * index),
+           ((const char *)recordptr) + soa->fields[i].offset, fieldsize);
+  }
+
+  if (index == soa->length) {
+    soa->length += 1;
+  }
+
+  *soa->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_soa_get(const cdyar_soa *soa, const size_t index,
+                               void *outptr) {
+  // check soa is not null
+  if (!soa) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(soa->code);
+
+  // check outptr is not null
+  if (!outptr) {
+    *soa->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // check that the columns exist
+  if (!soa->columns || !soa->fields) {
+    *soa->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // bounds checking
+  if (index >= soa->length) {
+    *soa->code = CDYAR_ARR_OUT_OF_BOUNDS;
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+
+  // gather the fields of the record from their columns
+  for (size_t i = 0; i < soa->fieldcount; i++) {
+    size_t fieldsize = soa->fields[i].size;
+    memcpy(((char *)outptr) + soa->fields[i].offset,
+           ((const char *)soa->columns[i]) + (fieldsize * index), fieldsize);
+  }
+
+  *soa->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_soa_rm(cdyar_soa *soa, const size_t index) {
+  // check that soa is not null
+  if (!soa) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check that code is not null
+  CDYAR_CHECK_CODE(soa->code);
+
+  // check that the columns exist
+  if (!soa->columns || !soa->fields) {
+    *soa->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // check for out of bounds
+  if (index >= soa->length) {
+    *soa->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // shift the records after index one step to the left in every column
+  size_t moved = soa->length - index - 1;
+  for (size_t i = 0; i < soa->fieldcount; i++) {
+    size_t fieldsize = soa->fields[i].size;
+    char *column = soa->columns[i];
+    memmove(column + (fieldsize * index), column + (fieldsize * (index + 1)),
+            fieldsize * moved);
+  }
+
+  soa->length--;
+  *soa->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_soa_column(const cdyar_soa *soa, const size_t field,
+                                  void **outptr) {
+  // check soa is not null
+  if (!soa) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(soa->code);
+
+  // check outptr is not null and that the field exists
+  if (!outptr || field >= soa->fieldcount) {
+    *soa->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // check that the columns exist
+  if (!soa->columns) {
+    *soa->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  *outptr = soa->columns[field];
+  *soa->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_soa_setpolicy(cdyar_soa *soa,
+                                     const cdyar_soa_resizepolicy policy) {
+  // check that soa is not null
+  if (!soa) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check that code is not null
+  CDYAR_CHECK_CODE(soa->code);
+
+  // check that policy is not null
+  if (!policy) {
+    *soa->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // assign new policy and indicate success
+  soa->policy = policy;
+  *soa->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
@@ -0,0 +1,369 @@
+#include "../headers/cdyar_sparse.h"
+#include "../headers/cdyar_arithmetic.h"
+#include <string.h>
+
+/** minimum number of slots of the page table */
+#define CDYAR_SPARSE_MIN_SLOTS 8
+
+/*
+    internal function
+    hash a page number into the page table, a 64-bit finalizer so that
+   consecutive pages spread over the whole table
+*/
+static size_t cdyar_sparse_hash(size_t number) {
+  uint64_t hash = (uint64_t)number;
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return (size_t)hash;
+}
+
+/*
+    internal function
+    slot of the page table that holds page number, or the empty slot where
+   it would be inserted
+*/
+static size_t cdyar_sparse_slot(const cdyar_sparse *sparse, size_t number) {
+  size_t mask = sparse->slotcount - 1;
+  size_t slot = cdyar_sparse_hash(number) & mask;
+  while (sparse->pages[slot] && sparse->pages[slot]->number != number) {
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+/*
+    internal function
+    check the parts of a sparse array every operation relies on
+*/
+static cdyar_returncode cdyar_sparse_validate(const cdyar_sparse *sparse) {
+  // check that a page table exists and there is a handler
+  if (!sparse->pages || !sparse->handler) {
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // check that the bookkeeping is consistent
+  if (sparse->typesize == 0 || sparse->slotcount < CDYAR_SPARSE_MIN_SLOTS ||
+      (sparse->slotcount & (sparse->slotcount - 1)) != 0 ||
+      sparse->pagecount >= sparse->slotcount) {
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  return CDYAR_SUCCESSFUL;
+}
+
+/*
+    internal function
+    doubles the number of slots of the page table and reinserts every page
+
+    args: 1) cdyar_sparse* sparse  : a pointer to the sparse array
+          2) cdyar_returncode* code: a pointer to a returncode variable to
+   store status returns: void
+*/
+static void cdyar_sparse_grow(cdyar_sparse *sparse, cdyar_returncode *code) {
+  // check code is not null
+  CDYAR_CHECK_CODE(code);
+
+  // check overflow
+  size_t doubled, bytes;
+  if (cdyar_mul_overflows(sparse->slotcount, 2, &doubled) ||
+      cdyar_mul_overflows(doubled, sizeof(cdyar_sparsepage *), &bytes)) {
+    *code = CDYAR_SIZE_T_OVERFLOW;
+    return;
+  }
+
+  cdyar_sparsepage **pages_temp = calloc(doubled, sizeof(cdyar_sparsepage *));
+  if (!pages_temp) {
+    *code = CDYAR_MEMORY_ERROR;
+    return;
+  }
+
+  cdyar_sparsepage **oldpages = sparse->pages;
+  size_t oldslotcount = sparse->slotcount;
+  sparse->pages = pages_temp;
+  sparse->slotcount = doubled;
+  for (size_t i = 0; i < oldslotcount; i++) {
+    if (oldpages[i]) {
+      sparse->pages[cdyar_sparse_slot(sparse, oldpages[i]->number)] =
+          oldpages[i];
+    }
+  }
+
+  free(oldpages);
+  *code = CDYAR_SUCCESSFUL;
+}
+
+/*
+    internal function
+    removes the page at a slot of the page table. the pages after it in the
+   same probe run are shifted back so lookups never stop at a hole
+*/
+static void cdyar_sparse_unlink(cdyar_sparse *sparse, size_t slot) {
+  size_t mask = sparse->slotcount - 1;
+  free(sparse->pages[slot]);
+  sparse->pages[slot] = NULL;
+  sparse->pagecount -= 1;
+
+  for (size_t next = (slot + 1) & mask; sparse->pages[next];
+       next = (next + 1) & mask) {
+    size_t home = cdyar_sparse_hash(sparse->pages[next]->number) & mask;
+    // the page can fill the hole unless its home lies cyclically in
+    // (slot, next]
+    if (((next - home) & mask) >= ((next - slot) & mask)) {
+      sparse->pages[slot] = sparse->pages[next];
+      sparse->pages[next] = NULL;
+      slot = next;
+    }
+  }
+}
+
+cdyar_returncode cdyar_nsparse(const size_t typesize,
+                               const cdyar_typehandler handler,
+                               cdyar_sparse *outptr) {
+  // make sure outptr is not null
+  if (!outptr) {
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // make sure typesize is positive and handler is not null
+  if (typesize == 0 || !handler) {
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // make sure a whole page can be allocated without overflow
+  if (typesize > (SIZE_MAX - sizeof(cdyar_sparsepage)) /
+                     CDYAR_SPARSE_PAGE_SIZE) {
+    return CDYAR_SIZE_T_OVERFLOW;
+  }
+
+  // create a cdyar_returncode for the sparse array
+  cdyar_returncode *code = malloc(sizeof(cdyar_returncode));
+  if (!code) {
+    return CDYAR_MEMORY_ERROR;
+  }
+  *code = CDYAR_SUCCESSFUL;
+
+  // allocate an empty page table
+  outptr->pages = calloc(CDYAR_SPARSE_MIN_SLOTS, sizeof(cdyar_sparsepage *));
+  if (!outptr->pages) {
+    free(code);
+    return CDYAR_MEMORY_ERROR;
+  }
+
+  // set properties, indicate success
+  outptr->slotcount = CDYAR_SPARSE_MIN_SLOTS;
+  outptr->pagecount = 0;
+  outptr->count = 0;
+  outptr->typesize = typesize;
+  outptr->handler = handler;
+  outptr->code = code;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_dsparse(cdyar_sparse *sparse) {
+  // make sure sparse is not null
+  if (!sparse) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  CDYAR_CHECK_CODE(sparse->code);
+
+  // if the page table exists, free every page and then the table
+  if (sparse->pages) {
+    for (size_t i = 0; i < sparse->slotcount; i++) {
+      free(sparse->pages[i]);
+    }
+    free(sparse->pages);
+    sparse->pages = NULL;
+  } else {
+    *sparse->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  sparse->slotcount = 0;
+  sparse->pagecount = 0;
+  sparse->count = 0;
+
+  // free code
+  cdyar_returncode tempcode = *sparse->code;
+  free(sparse->code);
+  sparse->code = NULL;
+
+  return tempcode;
+}
+
+cdyar_returncode cdyar_sparse_set(cdyar_sparse *sparse, const size_t index,
+                                  void *valueptr) {
+  // check that sparse is not null
+  if (!sparse) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check that code is not null
+  CDYAR_CHECK_CODE(sparse->code);
+
+  // check that valueptr is not null
+  if (!valueptr) {
+    *sparse->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  *sparse->code = cdyar_sparse_validate(sparse);
+  if (*sparse->code != CDYAR_SUCCESSFUL) {
+    return *sparse->code;
+  }
+
+  size_t number = index / CDYAR_SPARSE_PAGE_SIZE;
+  size_t offset = index % CDYAR_SPARSE_PAGE_SIZE;
+  size_t slot = cdyar_sparse_slot(sparse, number);
+
+  // first write to this page, allocate it
+  if (!sparse->pages[slot]) {
+    // keep the table at most half full so probe runs stay short
+    if ((sparse->pagecount + 1) * 2 > sparse->slotcount) {
+      cdyar_sparse_grow(sparse, sparse->code);
+      if (*sparse->code != CDYAR_SUCCESSFUL) {
+        return *sparse->code;
+      }
+      slot = cdyar_sparse_slot(sparse, number);
+    }
+
+    cdyar_sparsepage *page =
+        calloc(1, sizeof(cdyar_sparsepage) +
+                      (CDYAR_SPARSE_PAGE_SIZE * sparse->typesize));
+    if (!page) {
+      *sparse->code = CDYAR_MEMORY_ERROR;
+      return CDYAR_MEMORY_ERROR;
+    }
+    page->number = number;
+    sparse->pages[slot] = page;
+    sparse->pagecount += 1;
+  }
+
+  cdyar_sparsepage *page = sparse->pages[slot];
+  sparse->handler(page->elements + (offset * sparse->typesize), valueptr,
+                  CDYAR_DIRECTION_ASSIGN_RIGHT_TO_LEFT, sparse->typesize,
+                  sparse->code);
+  if (*sparse->code == CDYAR_SUCCESSFUL &&
+      !(page->present & ((uint64_t)1 << offset))) {
+    page->present |= (uint64_t)1 << offset;
+    sparse->count += 1;
+  }
+
+  // a failed first write must not leave an empty page behind
+  if (page->present == 0) {
+    cdyar_sparse_unlink(sparse, slot);
+  }
+
+  return *sparse->code;
+}
+
+cdyar_returncode cdyar_sparse_get(const cdyar_sparse *sparse,
+                                  const size_t index, void *outptr) {
+  // check that sparse is not null
+  if (!sparse) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check that code is not null
+  CDYAR_CHECK_CODE(sparse->code);
+
+  // check that outptr is not null
+  if (!outptr) {
+    *sparse->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  *sparse->code = cdyar_sparse_validate(sparse);
+  if (*sparse->code != CDYAR_SUCCESSFUL) {
+    return *sparse->code;
+  }
+
+  size_t offset = index % CDYAR_SPARSE_PAGE_SIZE;
+  cdyar_sparsepage *page =
+      sparse->pages[cdyar_sparse_slot(sparse, index / CDYAR_SPARSE_PAGE_SIZE)];
+
+  // slots that were never written read as zeros
+  if (!page || !(page->present & ((uint64_t)1 << offset))) {
+    memset(outptr, 0, sparse->typesize);
+    *sparse->code = CDYAR_SUCCESSFUL;
+    return CDYAR_SUCCESSFUL;
+  }
+
+  sparse->handler(page->elements + (offset * sparse->typesize), outptr,
+                  CDYAR_DIRECTION_ASSIGN_LEFT_TO_RIGHT, sparse->typesize,
+                  sparse->code);
+  return *sparse->code;
+}
+
+cdyar_returncode cdyar_sparse_has(const cdyar_sparse *sparse,
+                                  const size_t index, cdyar_bool *outptr) {
+  // check that sparse is not null
+  if (!sparse) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check that code is not null
+  CDYAR_CHECK_CODE(sparse->code);
+
+  // check that outptr is not null
+  if (!outptr) {
+    *sparse->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  *sparse->code = cdyar_sparse_validate(sparse);
+  if (*sparse->code != CDYAR_SUCCESSFUL) {
+    return *sparse->code;
+  }
+
+  cdyar_sparsepage *page =
+      sparse->pages[cdyar_sparse_slot(sparse, index / CDYAR_SPARSE_PAGE_SIZE)];
+  *outptr = page && (page->present &
+                     ((uint64_t)1 << (index % CDYAR_SPARSE_PAGE_SIZE)))
+                ? cdyar_true
+                : cdyar_false;
+
+  *sparse->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_sparse_rm(cdyar_sparse *sparse, const size_t index) {
+  // check that sparse is not null
+  if (!sparse) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check that code is not null
+  CDYAR_CHECK_CODE(sparse->code);
+
+  *sparse->code = cdyar_sparse_validate(sparse);
+  if (*sparse->code != CDYAR_SUCCESSFUL) {
+    return *sparse->code;
+  }
+
+  size_t offset = index % CDYAR_SPARSE_PAGE_SIZE;
+  size_t slot = cdyar_sparse_slot(sparse, index / CDYAR_SPARSE_PAGE_SIZE);
+  cdyar_sparsepage *page = sparse->pages[slot];
+
+  // make sure there is an element to remove
+  if (!page || !(page->present & ((uint64_t)1 << offset))) {
+    *sparse->code = CDYAR_ARR_OUT_OF_BOUNDS;
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+
+  page->present &= ~((uint64_t)1 << offset);
+  sparse->count -= 1;
+
+  // free pages as soon as they are empty, otherwise zero the slot so it
+  // reads as zeros and a later first write starts from a clean slot
+  if (page->present == 0) {
+    cdyar_sparse_unlink(sparse, slot);
+  } else {
+    memset(page->elements + (offset * sparse->typesize), 0, sparse->typesize);
+  }
+
+  *sparse->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
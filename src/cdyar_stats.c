@@ -0,0 +1,91 @@
+#include "../headers/cdyar_stats.h"
+#include "../headers/cdyar_darray.h"
+#include <string.h>
+
+#ifdef CDYAR_STATS
+
+// aggregate counters, static storage starts them at zero
+cdyar_globalstats cdyar_global_stats;
+
+void cdyar_stats_notepeak(cdyar_darray *arr) {
+  if (arr->capacity > arr->stats.peak_capacity) {
+    arr->stats.peak_capacity = arr->capacity;
+  }
+
+  // raise the global peak unless another array already went higher
+  size_t peak = atomic_load_explicit(&cdyar_global_stats.peak_capacity,
+                                     memory_order_relaxed);
+  while (arr->capacity > peak &&
+         !atomic_compare_exchange_weak_explicit(
+             &cdyar_global_stats.peak_capacity, &peak, arr->capacity,
+             memory_order_relaxed, memory_order_relaxed)) {
+  }
+}
+
+#endif
+
+cdyar_returncode cdyar_getstats(const cdyar_darray *arr, cdyar_stats *outptr) {
+  // check arr is not null
+  if (!arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check outptr is not null
+  if (!outptr) {
+    return CDYAR_INVALID_INPUT;
+  }
+
+#ifdef CDYAR_STATS
+  *outptr = arr->stats;
+  return CDYAR_SUCCESSFUL;
+#else
+  // counters were compiled out
+  memset(outptr, 0, sizeof(cdyar_stats));
+  return CDYAR_FAILED;
+#endif
+}
+
+cdyar_returncode cdyar_getglobalstats(cdyar_stats *outptr) {
+  // check outptr is not null
+  if (!outptr) {
+    return CDYAR_INVALID_INPUT;
+  }
+
+#ifdef CDYAR_STATS
+  outptr->resizes = atomic_load(&cdyar_global_stats.resizes);
+  outptr->resize_bytes = atomic_load(&cdyar_global_stats.resize_bytes);
+  outptr->peak_capacity = atomic_load(&cdyar_global_stats.peak_capacity);
+  outptr->sets = atomic_load(&cdyar_global_stats.sets);
+  outptr->gets = atomic_load(&cdyar_global_stats.gets);
+  outptr->rms = atomic_load(&cdyar_global_stats.rms);
+  outptr->handler_calls = atomic_load(&cdyar_global_stats.handler_calls);
+  outptr->shift_moves = atomic_load(&cdyar_global_stats.shift_moves);
+  return CDYAR_SUCCESSFUL;
+#else
+  // counters were compiled out
+  memset(outptr, 0, sizeof(cdyar_stats));
+  return CDYAR_FAILED;
+#endif
+}
+
+cdyar_returncode cdyar_printstats(const cdyar_darray *arr, FILE *destination) {
+  // check that the destination exists and is not stdin
+  if (!destination || destination == stdin) {
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // a null array selects the aggregate counters
+  cdyar_stats stats;
+  cdyar_returncode code =
+      arr ? cdyar_getstats(arr, &stats) : cdyar_getglobalstats(&stats);
+  if (code != CDYAR_SUCCESSFUL) {
+    return code;
+  }
+
+  fprintf(destination,
+          "cdyar stats: resizes=%zu resize_bytes=%zu peak_capacity=%zu "
+          "sets=%zu gets=%zu rms=%zu handler_calls=%zu shift_moves=%zu\n",
+          stats.resizes, stats.resize_bytes, stats.peak_capacity, stats.sets,
+          stats.gets, stats.rms, stats.handler_calls, stats.shift_moves);
+  return CDYAR_SUCCESSFUL;
+}
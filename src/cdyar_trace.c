@@ -0,0 +1,337 @@
+#include "../headers/cdyar_trace.h"
+#include "../headers/cdyar_types.h"
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+/** magic bytes every trace starts with */
+static const unsigned char cdyar_trace_magic[4] = {'C', 'D', 'Y', 'T'};
+
+/** longest LEB128 encoding of a size_t */
+#define CDYAR_TRACE_MAX_VARINT ((sizeof(size_t) * 8 + 6) / 7)
+
+/** longest encoding of a single event */
+#define CDYAR_TRACE_MAX_EVENT (1 + 3 * CDYAR_TRACE_MAX_VARINT)
+
+/*
+    internal struct
+    a decoded event, replayed once the whole log has been read
+*/
+typedef struct cdyar_traceevent {
+  cdyar_traceop op;
+  size_t first;
+  size_t second;
+  size_t third;
+} cdyar_traceevent;
+
+/*
+    internal function
+    write the buffered events to the destination stream
+*/
+static void cdyar_trace_flush(cdyar_trace *trace) {
+  if (trace->used != 0 &&
+      fwrite(trace->buffer, 1, trace->used, trace->destination) !=
+          trace->used) {
+    trace->failed = cdyar_true;
+  }
+  trace->used = 0;
+}
+
+/*
+    internal function
+    append a value to the buffer as an unsigned LEB128 varint, the caller
+   makes sure there is room for it
+*/
+static void cdyar_trace_varint(cdyar_trace *trace, size_t value) {
+  do {
+    unsigned char byte = value & 0x7f;
+    value >>= 7;
+    trace->buffer[trace->used++] = byte | (value ? 0x80 : 0);
+  } while (value);
+}
+
+/*
+    internal function
+    read an unsigned LEB128 varint, returns cdyar_false on a truncated or
+   oversized value
+*/
+static cdyar_bool cdyar_trace_readvarint(FILE *source, size_t *outptr) {
+  size_t value = 0;
+  for (unsigned shift = 0; shift < sizeof(size_t) * 8; shift += 7) {
+    int byte = fgetc(source);
+    if (byte == EOF) {
+      return cdyar_false;
+    }
+    value |= ((size_t)(byte & 0x7f)) << shift;
+    if (!(byte & 0x80)) {
+      *outptr = value;
+      return cdyar_true;
+    }
+  }
+  return cdyar_false;
+}
+
+void cdyar_trace_record(cdyar_trace *trace, const cdyar_traceop op,
+                        const size_t first, const size_t second) {
+  // make sure a whole event fits before encoding it
+  if (trace->used > CDYAR_TRACE_BUFFER - CDYAR_TRACE_MAX_EVENT) {
+    cdyar_trace_flush(trace);
+  }
+
+  trace->buffer[trace->used++] = (unsigned char)op;
+  switch (op) {
+  case CDYAR_TRACE_RESIZE:
+    cdyar_trace_varint(trace, first);
+    cdyar_trace_varint(trace, second);
+    break;
+  case CDYAR_TRACE_DESTROY:
+    break;
+  default:
+    cdyar_trace_varint(trace, first);
+    break;
+  }
+}
+
+cdyar_returncode cdyar_attachtrace(cdyar_darray *arr, FILE *destination) {
+  // check arr is not null
+  if (!arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // an array carries at most one trace, and it needs somewhere to go
+  if (arr->trace || !destination) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  cdyar_trace *trace = malloc(sizeof(cdyar_trace));
+  if (!trace) {
+    *arr->code = CDYAR_MEMORY_ERROR;
+    return CDYAR_MEMORY_ERROR;
+  }
+  trace->destination = destination;
+  trace->used = 0;
+  trace->failed = cdyar_false;
+
+  // header, then the state the array is in right now
+  memcpy(trace->buffer, cdyar_trace_magic, sizeof(cdyar_trace_magic));
+  trace->used = sizeof(cdyar_trace_magic);
+  trace->buffer[trace->used++] = CDYAR_TRACE_VERSION;
+  trace->buffer[trace->used++] = CDYAR_TRACE_CREATE;
+  cdyar_trace_varint(trace, arr->typesize);
+  cdyar_trace_varint(trace, arr->capacity);
+  cdyar_trace_varint(trace, arr->length);
+
+  arr->trace = trace;
+  *arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_detachtrace(cdyar_darray *arr) {
+  // check arr is not null
+  if (!arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // nothing to do without a trace
+  if (!arr->trace) {
+    *arr->code = CDYAR_SUCCESSFUL;
+    return CDYAR_SUCCESSFUL;
+  }
+
+  cdyar_trace_record(arr->trace, CDYAR_TRACE_DESTROY, 0, 0);
+  cdyar_trace_flush(arr->trace);
+  if (fflush(arr->trace->destination) != 0) {
+    arr->trace->failed = cdyar_true;
+  }
+
+  *arr->code = arr->trace->failed ? CDYAR_FAILED : CDYAR_SUCCESSFUL;
+  free(arr->trace);
+  arr->trace = NULL;
+  return *arr->code;
+}
+
+/*
+    internal function
+    decode every event of a log into events, up to the end of the first
+   array's lifetime
+*/
+static cdyar_returncode cdyar_trace_decode(FILE *source,
+                                           cdyar_darray *events) {
+  unsigned char header[sizeof(cdyar_trace_magic) + 1];
+  if (fread(header, 1, sizeof(header), source) != sizeof(header) ||
+      memcmp(header, cdyar_trace_magic, sizeof(cdyar_trace_magic)) != 0 ||
+      header[sizeof(cdyar_trace_magic)] != CDYAR_TRACE_VERSION) {
+    return CDYAR_INVALID_INPUT;
+  }
+
+  for (int op; (op = fgetc(source)) != EOF;) {
+    cdyar_traceevent event = {(cdyar_traceop)op, 0, 0, 0};
+    cdyar_bool valid = cdyar_true;
+
+    switch (op) {
+    case CDYAR_TRACE_CREATE:
+      valid = cdyar_trace_readvarint(source, &event.first) &&
+              cdyar_trace_readvarint(source, &event.second) &&
+              cdyar_trace_readvarint(source, &event.third);
+      break;
+    case CDYAR_TRACE_RESIZE:
+      valid = cdyar_trace_readvarint(source, &event.first) &&
+              cdyar_trace_readvarint(source, &event.second);
+      break;
+    case CDYAR_TRACE_SET:
+    case CDYAR_TRACE_GET:
+    case CDYAR_TRACE_RM:
+    case CDYAR_TRACE_SWAPRM:
+      valid = cdyar_trace_readvarint(source, &event.first);
+      break;
+    case CDYAR_TRACE_DESTROY:
+      return CDYAR_SUCCESSFUL;
+    default:
+      valid = cdyar_false;
+      break;
+    }
+
+    // only the very first event may create the array
+    if (!valid || (events->length == 0) != (op == CDYAR_TRACE_CREATE)) {
+      return CDYAR_INVALID_INPUT;
+    }
+
+    if (cdyar_set(events, events->length, &event) != CDYAR_SUCCESSFUL) {
+      return *events->code;
+    }
+  }
+
+  // a log cut short before the destroy event is still replayable
+  return events->length != 0 ? CDYAR_SUCCESSFUL : CDYAR_INVALID_INPUT;
+}
+
+/*
+    internal function
+    replay decoded events on arr and take measurements, events[0] is the
+   create event
+*/
+static void cdyar_trace_run(cdyar_darray *arr, const cdyar_traceevent *events,
+                            size_t count, void *value,
+                            cdyar_replayresult *result) {
+  for (size_t i = 1; i < count; i++) {
+    size_t index = events[i].first;
+    size_t capacity = arr->capacity;
+    size_t length = arr->length;
+    cdyar_returncode code;
+
+    switch (events[i].op) {
+    case CDYAR_TRACE_SET:
+      code = cdyar_set(arr, index, value);
+      if (code == CDYAR_SUCCESSFUL && arr->capacity != capacity) {
+        // both buffers exist while the elements are carried over
+        size_t footprint = (capacity + arr->capacity) * arr->typesize;
+        if (footprint > result->peak_bytes) {
+          result->peak_bytes = footprint;
+        }
+        result->resizes++;
+        result->copied_bytes += length * arr->typesize;
+      }
+      break;
+    case CDYAR_TRACE_GET:
+      code = cdyar_get(arr, index, value);
+      break;
+    case CDYAR_TRACE_RM:
+      code = cdyar_rm(arr, index);
+      if (code == CDYAR_SUCCESSFUL) {
+        result->copied_bytes += (length - 1 - index) * arr->typesize;
+      }
+      break;
+    case CDYAR_TRACE_SWAPRM:
+      code = cdyar_swaprm(arr, index);
+      if (code == CDYAR_SUCCESSFUL && index != length - 1) {
+        result->copied_bytes += arr->typesize;
+      }
+      break;
+    default:
+      // recorded resizes belong to the recorded policy
+      continue;
+    }
+
+    result->operations++;
+    if (code != CDYAR_SUCCESSFUL) {
+      result->failures++;
+    }
+  }
+}
+
+static double cdyar_trace_now(void) {
+  struct timespec ts;
+  timespec_get(&ts, TIME_UTC);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+cdyar_returncode cdyar_replay(FILE *source, const cdyar_resizepolicy policy,
+                              const size_t alignment, const cdyar_flag flags,
+                              cdyar_replayresult *outptr) {
+  // make sure source and outptr are not null
+  if (!source || !outptr) {
+    return CDYAR_INVALID_INPUT;
+  }
+
+  cdyar_darray events;
+  cdyar_returncode code =
+      cdyar_narr(sizeof(cdyar_traceevent), 64, CDYAR_DEFAULT_RESIZE_POLICY,
+                 cdyar_generic_typehandler, CDYAR_ARR_AUTO_RESIZE, &events);
+  if (code != CDYAR_SUCCESSFUL) {
+    return code;
+  }
+
+  code = cdyar_trace_decode(source, &events);
+  if (code != CDYAR_SUCCESSFUL) {
+    cdyar_darr(&events);
+    return code;
+  }
+
+  const cdyar_traceevent *decoded = events.elements;
+  size_t typesize = decoded[0].first;
+  size_t capacity = decoded[0].second;
+  size_t length = decoded[0].third;
+
+  // build the array in the state it was in when recording started
+  cdyar_darray arr;
+  code = cdyar_narr_aligned(typesize, capacity, alignment, policy,
+                            cdyar_generic_typehandler, flags, &arr);
+  if (code != CDYAR_SUCCESSFUL) {
+    cdyar_darr(&events);
+    return code;
+  }
+  void *value = calloc(1, typesize);
+  if (!value) {
+    cdyar_darr(&arr);
+    cdyar_darr(&events);
+    return CDYAR_MEMORY_ERROR;
+  }
+  for (size_t i = 0; i < length; i++) {
+    if (cdyar_set(&arr, i, value) != CDYAR_SUCCESSFUL) {
+      code = *arr.code;
+      free(value);
+      cdyar_darr(&arr);
+      cdyar_darr(&events);
+      return code;
+    }
+  }
+
+  memset(outptr, 0, sizeof(cdyar_replayresult));
+  outptr->peak_bytes = arr.capacity * arr.typesize;
+
+  double start = cdyar_trace_now();
+  cdyar_trace_run(&arr, decoded, events.length, value, outptr);
+  outptr->seconds = cdyar_trace_now() - start;
+
+  free(value);
+  cdyar_darr(&arr);
+  cdyar_darr(&events);
+  return CDYAR_SUCCESSFUL;
+}
@@ -0,0 +1,452 @@
+#include "../headers/cdyar_view.h"
+#include <stdint.h>
+#include <string.h>
+
+/*
+    internal function
+    magnitude of a ptrdiff_t as a size_t (computed by hand because
+   -PTRDIFF_MIN overflows)
+*/
+static size_t cdyar_view_magnitude(ptrdiff_t value) {
+  return value >= 0 ? (size_t)value : (size_t)0 - (size_t)value;
+}
+
+/*
+    internal function
+    check the parts of an array a view is created from, settle any
+   incremental resize and unshare the buffer, so that the elements live in a
+   single buffer owned by arr
+*/
+static cdyar_returncode cdyar_view_source(cdyar_darray *arr, void *outptr) {
+  // check arr is not null
+  if (!arr) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check code is not null
+  CDYAR_CHECK_CODE(arr->code);
+
+  // check outptr is not null
+  if (!outptr) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // views copy, overwrite and swap elements bitwise, which is only safe for
+  // elements that own nothing and can be moved with memcpy
+  if (arr->type && (!arr->type->relocatable || arr->type->destroy)) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // check that an elements array actually exists within the dynamic array
+  if (!arr->elements || arr->typesize == 0) {
+    *arr->code = CDYAR_CORRUPTED_DYNAMIC_ARR;
+    return CDYAR_CORRUPTED_DYNAMIC_ARR;
+  }
+
+  // the view points into a single buffer, an incremental resize must be done
+  if (cdyar_finishresize(arr) != CDYAR_SUCCESSFUL) {
+    return *arr->code;
+  }
+
+  // writes through the view must not show up in clones sharing the buffer
+  if (cdyar_unshare(arr) != CDYAR_SUCCESSFUL) {
+    return *arr->code;
+  }
+
+  // strides are ptrdiff_t, so the whole buffer has to be addressable by one
+  if (arr->length > (size_t)PTRDIFF_MAX / arr->typesize) {
+    *arr->code = CDYAR_SIZE_T_OVERFLOW;
+    return CDYAR_SIZE_T_OVERFLOW;
+  }
+
+  return CDYAR_SUCCESSFUL;
+}
+
+/*
+    internal function
+    swap two elements of typesize bytes without a temporary buffer
+*/
+static void cdyar_view_swap(char *left, char *right, size_t typesize) {
+  for (size_t i = 0; i < typesize; i++) {
+    char temp = left[i];
+    left[i] = right[i];
+    right[i] = temp;
+  }
+}
+
+/*
+    internal function
+    move the element at index down the max-heap made of the first length
+   elements of a view until both of its children order before it
+*/
+static void cdyar_view_siftdown(const cdyar_view *view, size_t index,
+                                size_t length, cdyar_comparator cmp) {
+  for (;;) {
+    size_t largest = index;
+    size_t left = (2 * index) + 1;
+    if (left < length && cmp(cdyar_view_at(view, left),
+                             cdyar_view_at(view, largest)) > 0) {
+      largest = left;
+    }
+    if (left + 1 < length && cmp(cdyar_view_at(view, left + 1),
+                                 cdyar_view_at(view, largest)) > 0) {
+      largest = left + 1;
+    }
+    if (largest == index) {
+      return;
+    }
+    cdyar_view_swap(cdyar_view_at(view, index), cdyar_view_at(view, largest),
+                    view->typesize);
+    index = largest;
+  }
+}
+
+cdyar_returncode cdyar_nview(cdyar_darray *arr, const size_t start,
+                             const size_t length, cdyar_view *outptr) {
+  cdyar_returncode code = cdyar_view_source(arr, outptr);
+  if (code != CDYAR_SUCCESSFUL) {
+    return code;
+  }
+
+  // bounds checking, written so that start + length can't overflow
+  if (start > arr->length || length > arr->length - start) {
+    *arr->code = CDYAR_ARR_OUT_OF_BOUNDS;
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+
+  outptr->base = ((char *)arr->elements) + (arr->typesize * start);
+  outptr->length = length;
+  outptr->typesize = arr->typesize;
+  outptr->stride = (ptrdiff_t)arr->typesize;
+
+  *arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_nview_strided(cdyar_darray *arr, const size_t start,
+                                     const size_t step, cdyar_view *outptr) {
+  cdyar_returncode code = cdyar_view_source(arr, outptr);
+  if (code != CDYAR_SUCCESSFUL) {
+    return code;
+  }
+
+  // a step of zero would view the same element over and over
+  if (step == 0) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // bounds checking
+  if (start >= arr->length) {
+    *arr->code = CDYAR_ARR_OUT_OF_BOUNDS;
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+
+  // make sure the stride in bytes fits in a ptrdiff_t
+  if (step > (size_t)PTRDIFF_MAX / arr->typesize) {
+    *arr->code = CDYAR_SIZE_T_OVERFLOW;
+    return CDYAR_SIZE_T_OVERFLOW;
+  }
+
+  outptr->base = ((char *)arr->elements) + (arr->typesize * start);
+  outptr->length = 1 + ((arr->length - 1 - start) / step);
+  outptr->typesize = arr->typesize;
+  outptr->stride = (ptrdiff_t)(step * arr->typesize);
+
+  *arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_nview_field(cdyar_darray *arr, const size_t offset,
+                                   const size_t fieldsize, cdyar_view *outptr) {
+  cdyar_returncode code = cdyar_view_source(arr, outptr);
+  if (code != CDYAR_SUCCESSFUL) {
+    return code;
+  }
+
+  // the field has to lie inside an element
+  if (fieldsize == 0 || offset >= arr->typesize ||
+      fieldsize > arr->typesize - offset) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  outptr->base = ((char *)arr->elements) + offset;
+  outptr->length = arr->length;
+  outptr->typesize = fieldsize;
+  outptr->stride = (ptrdiff_t)arr->typesize;
+
+  *arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_view_slice(const cdyar_view *view, const size_t start,
+                                  const size_t length, const ptrdiff_t step,
+                                  cdyar_view *outptr) {
+  // check view and outptr are not null
+  if (!view) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+  if (!outptr || step == 0) {
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // an empty slice may start anywhere up to the end of the view
+  if (length == 0) {
+    if (start > view->length) {
+      return CDYAR_ARR_OUT_OF_BOUNDS;
+    }
+    outptr->base = view->base;
+    outptr->length = 0;
+    outptr->typesize = view->typesize;
+    outptr->stride = view->stride;
+    return CDYAR_SUCCESSFUL;
+  }
+
+  // the first and last element of the slice both have to be in the view
+  size_t magnitude = cdyar_view_magnitude(step);
+  if (start >= view->length) {
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+  size_t room = step > 0 ? view->length - 1 - start : start;
+  if ((length - 1) > room / magnitude) {
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+
+  // a longer slice spans its stride inside the viewed buffer, so only the
+  // stride of a lone element could overflow, and that one is never used
+  ptrdiff_t stride = view->stride;
+  if (length > 1) {
+    stride *= (ptrdiff_t)magnitude;
+  }
+
+  outptr->base = cdyar_view_at(view, start);
+  outptr->length = length;
+  outptr->typesize = view->typesize;
+  outptr->stride = step > 0 ? stride : -stride;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_view_get(const cdyar_view *view, const size_t index,
+                                void *outptr) {
+  // check view is not null
+  if (!view) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check outptr is not null
+  if (!outptr) {
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // bounds checking
+  if (index >= view->length) {
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+
+  memcpy(outptr, cdyar_view_at(view, index), view->typesize);
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_view_find(const cdyar_view *view, const void *keyptr,
+                                 const cdyar_comparator cmp, size_t *outptr) {
+  // check view is not null
+  if (!view) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check keyptr, cmp and outptr are not null
+  if (!keyptr || !cmp || !outptr) {
+    return CDYAR_INVALID_INPUT;
+  }
+
+  for (size_t i = 0; i < view->length; i++) {
+    if (cmp(cdyar_view_at(view, i), keyptr) == 0) {
+      *outptr = i;
+      return CDYAR_SUCCESSFUL;
+    }
+  }
+
+  return CDYAR_NOT_FOUND;
+}
+
+cdyar_returncode cdyar_view_sort(const cdyar_view *view,
+                                 const cdyar_comparator cmp) {
+  // check view is not null
+  if (!view) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check cmp is not null
+  if (!cmp) {
+    return CDYAR_INVALID_INPUT;
+  }
+
+  if (view->length < 2) {
+    return CDYAR_SUCCESSFUL;
+  }
+
+  // contiguous elements can go straight to qsort
+  if (view->stride == (ptrdiff_t)view->typesize) {
+    qsort(view->base, view->length, view->typesize, cmp);
+    return CDYAR_SUCCESSFUL;
+  }
+
+  // heapsort needs no scratch memory and works with any stride
+  for (size_t i = view->length / 2; i-- > 0;) {
+    cdyar_view_siftdown(view, i, view->length, cmp);
+  }
+  for (size_t end = view->length - 1; end > 0; end--) {
+    cdyar_view_swap(view->base, cdyar_view_at(view, end), view->typesize);
+    cdyar_view_siftdown(view, 0, end, cmp);
+  }
+
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_view_cursor(const cdyar_view *view,
+                                   const size_t prefetch,
+                                   cdyar_cursor *outptr) {
+  // check view is not null
+  if (!view) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+
+  // check outptr is not null
+  if (!outptr) {
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // make sure the prefetch distance in bytes fits in a ptrdiff_t
+  size_t stride = cdyar_view_magnitude(view->stride);
+  if (prefetch != 0 && stride != 0 && prefetch > (size_t)PTRDIFF_MAX / stride) {
+    return CDYAR_SIZE_T_OVERFLOW;
+  }
+
+  outptr->current = view->base;
+  outptr->stride = view->stride;
+  outptr->remaining = view->length;
+  outptr->prefetch = (ptrdiff_t)prefetch * view->stride;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_nview2d(cdyar_darray *arr, const size_t rows,
+                               const size_t cols, cdyar_view2d *outptr) {
+  cdyar_returncode code = cdyar_view_source(arr, outptr);
+  if (code != CDYAR_SUCCESSFUL) {
+    return code;
+  }
+
+  // an empty matrix has no meaningful strides
+  if (rows == 0 || cols == 0) {
+    *arr->code = CDYAR_INVALID_INPUT;
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // the whole matrix has to fit inside the array's length
+  if (rows > arr->length / cols) {
+    *arr->code = CDYAR_ARR_OUT_OF_BOUNDS;
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+
+  outptr->base = arr->elements;
+  outptr->rows = rows;
+  outptr->cols = cols;
+  outptr->typesize = arr->typesize;
+  outptr->rowstride = (ptrdiff_t)(cols * arr->typesize);
+  outptr->colstride = (ptrdiff_t)arr->typesize;
+
+  *arr->code = CDYAR_SUCCESSFUL;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_view2d_row(const cdyar_view2d *view, const size_t row,
+                                  cdyar_view *outptr) {
+  // check view and outptr are not null
+  if (!view) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+  if (!outptr) {
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // bounds checking
+  if (row >= view->rows) {
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+
+  outptr->base = cdyar_view2d_at(view, row, 0);
+  outptr->length = view->cols;
+  outptr->typesize = view->typesize;
+  outptr->stride = view->colstride;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_view2d_col(const cdyar_view2d *view, const size_t col,
+                                  cdyar_view *outptr) {
+  // check view and outptr are not null
+  if (!view) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+  if (!outptr) {
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // bounds checking
+  if (col >= view->cols) {
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+
+  outptr->base = cdyar_view2d_at(view, 0, col);
+  outptr->length = view->rows;
+  outptr->typesize = view->typesize;
+  outptr->stride = view->rowstride;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_view2d_block(const cdyar_view2d *view, const size_t row,
+                                    const size_t col, const size_t rows,
+                                    const size_t cols, cdyar_view2d *outptr) {
+  // check view and outptr are not null
+  if (!view) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+  if (!outptr || rows == 0 || cols == 0) {
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // bounds checking, written so that row + rows and col + cols can't overflow
+  if (row >= view->rows || rows > view->rows - row || col >= view->cols ||
+      cols > view->cols - col) {
+    return CDYAR_ARR_OUT_OF_BOUNDS;
+  }
+
+  cdyar_view2d block = *view;
+  block.base = cdyar_view2d_at(view, row, col);
+  block.rows = rows;
+  block.cols = cols;
+  *outptr = block;
+  return CDYAR_SUCCESSFUL;
+}
+
+cdyar_returncode cdyar_view2d_transpose(const cdyar_view2d *view,
+                                        cdyar_view2d *outptr) {
+  // check view and outptr are not null
+  if (!view) {
+    return CDYAR_DYNAMIC_ARR_DOES_NOT_EXIST;
+  }
+  if (!outptr) {
+    return CDYAR_INVALID_INPUT;
+  }
+
+  // swapping the strides swaps the roles of rows and columns
+  cdyar_view2d transposed = *view;
+  transposed.rows = view->cols;
+  transposed.cols = view->rows;
+  transposed.rowstride = view->colstride;
+  transposed.colstride = view->rowstride;
+  *outptr = transposed;
+  return CDYAR_SUCCESSFUL;
+}
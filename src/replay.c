@@ -0,0 +1,116 @@
+#include "../headers/cdyar.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// replays a trace recorded with cdyar_attachtrace against resize policies,
+// built with release flags by 'make replay'
+// usage: cdyar_replay <trace> [policy...] [--inline-code] [--align N]
+//        [--hugepages]
+// every policy is replayed in turn (all of them by default) and reported as
+// one CSV row: policy,operations,failures,resizes,copied_bytes,peak_bytes,seconds
+// --align N replays with an elements buffer aligned to N bytes (a power of
+// two), --hugepages with CDYAR_ARR_HUGEPAGES
+
+static const struct {
+  const char *name;
+  cdyar_resizepolicy policy;
+} replay_policies[] = {
+    {"default", CDYAR_DEFAULT_RESIZE_POLICY},
+    {"incremental", cdyar_incremental_resize_policy},
+    {"adaptive", cdyar_adaptive_resize_policy},
+};
+
+#define REPLAY_POLICY_COUNT (sizeof(replay_policies) / sizeof(replay_policies[0]))
+
+static void replay_usage(const char *program) {
+  fprintf(stderr,
+          "usage: %s <trace> [policy...] [--inline-code] [--align N] "
+          "[--hugepages]\npolicies:",
+          program);
+  for (size_t i = 0; i < REPLAY_POLICY_COUNT; i++) {
+    fprintf(stderr, " %s", replay_policies[i].name);
+  }
+  fprintf(stderr, "\n");
+}
+
+static int replay_run(const char *path, size_t policy, size_t alignment,
+                      cdyar_flag flags) {
+  FILE *source = fopen(path, "rb");
+  if (!source) {
+    perror(path);
+    return 1;
+  }
+
+  cdyar_replayresult result;
+  cdyar_returncode code =
+      cdyar_replay(source, replay_policies[policy].policy, alignment, flags,
+                   &result);
+  fclose(source);
+  if (code != CDYAR_SUCCESSFUL) {
+    fprintf(stderr, "%s: replay failed: %s", path, CDYAR_ERR_MESSAGES[code]);
+    return 1;
+  }
+
+  printf("%s,%zu,%zu,%zu,%zu,%zu,%.6f\n", replay_policies[policy].name,
+         result.operations, result.failures, result.resizes,
+         result.copied_bytes, result.peak_bytes, result.seconds);
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    replay_usage(argv[0]);
+    return 1;
+  }
+
+  // pick the policies named on the command line
+  cdyar_bool selected[REPLAY_POLICY_COUNT] = {cdyar_false};
+  cdyar_bool any = cdyar_false;
+  cdyar_flag flags = CDYAR_ARR_AUTO_RESIZE;
+  size_t alignment = CDYAR_DEFAULT_ALIGNMENT;
+  for (int i = 2; i < argc; i++) {
+    if (strcmp(argv[i], "--inline-code") == 0) {
+      flags |= CDYAR_ARR_INLINE_CODE;
+      continue;
+    }
+    if (strcmp(argv[i], "--hugepages") == 0) {
+      flags |= CDYAR_ARR_HUGEPAGES;
+      continue;
+    }
+    if (strcmp(argv[i], "--align") == 0) {
+      char *end = NULL;
+      unsigned long long value = 0;
+      if (i + 1 < argc) {
+        value = strtoull(argv[++i], &end, 10);
+      }
+      if (!end || *end != '\0' || value > SIZE_MAX ||
+          !cdyar_memory_validalignment((size_t)value)) {
+        replay_usage(argv[0]);
+        return 1;
+      }
+      alignment = (size_t)value;
+      continue;
+    }
+
+    size_t p = 0;
+    while (p < REPLAY_POLICY_COUNT && strcmp(argv[i], replay_policies[p].name)) {
+      p++;
+    }
+    if (p == REPLAY_POLICY_COUNT) {
+      replay_usage(argv[0]);
+      return 1;
+    }
+    selected[p] = cdyar_true;
+    any = cdyar_true;
+  }
+
+  printf("policy,operations,failures,resizes,copied_bytes,peak_bytes,seconds\n");
+  for (size_t p = 0; p < REPLAY_POLICY_COUNT; p++) {
+    if ((!any || selected[p]) && replay_run(argv[1], p, alignment, flags)) {
+      return 1;
+    }
+  }
+  return 0;
+}